@@ -7,40 +7,72 @@
  * 
  * Thread Safety:
  * - All public APIs are thread-safe using mutexes
- * - Receiver runs on dedicated task (Core 0)
- * - Callbacks executed from receiver task context
+ * - Packets are received on the shared UDP dispatcher task (Core 0)
+ * - Callbacks executed from dispatcher task context
+ * - ArtPollReply is built and sent from an esp_timer callback; the receive
+ *   task only queues the poller's address
+ * 
+ * ArtPoll:
+ * - The replies are cached and only rebuilt after artnet_receiver_refresh_poll_reply()
+ * - Every output universe is announced in its own reply (bind index 1..n),
+ *   so outputs in different Nets or Sub-Nets are all discoverable
+ * - Replies go out after a random 0-1 s delay (Art-Net 4), one timer run
+ *   answering every poll queued in the meantime
+ * - A controller polling again within ARTNET_POLL_MIN_INTERVAL_MS is not
+ *   answered again, so a poll storm cannot load the receive task
  * 
  * Memory Usage:
- * - ~2KB for context and buffers
- * - Task stack: 4KB
- * - Total: ~6KB
+ * - ~1.9KB for context (including the cached replies)
+ * - ~1.5KB for the sequence tracker
+ * - Total: ~3.4KB
  */
 
 #include "artnet_receiver.h"
 #include "config_manager.h"
+#include "universe_router.h"
+#include "udp_dispatcher.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_netif.h"
+#include "esp_random.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "lwip/sockets.h"
 #include "lwip/netdb.h"
 #include <string.h>
+#include <stdatomic.h>
 #include <arpa/inet.h>
 
 static const char *TAG = "artnet_receiver";
 
-// Task configuration
-#define ARTNET_TASK_STACK_SIZE 4096
-#define ARTNET_TASK_PRIORITY   5
-#define ARTNET_TASK_CORE       0
+// A sender silent this long restarts its sequence (matches the merge timeout)
+#define ARTNET_SEQUENCE_TIMEOUT_MS 2500
+
+// Pollers answered by one timer run, and controllers tracked for rate limiting
+#define ARTNET_POLL_QUEUE_SIZE 4
+#define ARTNET_POLL_SOURCES    8
 
-// Buffer sizes
-#define ARTNET_MAX_PACKET_SIZE 1024
+// NodeReport: "#0001 [cccc] OK", the counter digits are patched in per reply
+#define ARTNET_NODE_REPORT_COUNTER_OFFSET 7
 
-// Timeout
-#define ARTNET_RECEIVE_TIMEOUT_MS 1000
+/**
+ * @brief One announced output: a DMX port and one universe it outputs
+ * 
+ * A port's secondary universe is announced as a virtual port of its own.
+ */
+typedef struct {
+    uint8_t dmx_port;              /**< DMX port (1..UNIVERSE_ROUTER_PORTS) */
+    uint16_t address;              /**< 15-bit Port-Address */
+} node_port_t;
+
+/**
+ * @brief Last reply time of one polling controller
+ */
+typedef struct {
+    uint32_t ip;                   /**< Controller address, 0 = unused */
+    uint32_t last_reply_ms;        /**< Time its last poll was answered */
+} poll_source_t;
 
 /**
  * @brief Module state
@@ -51,13 +83,25 @@ static struct {
     bool poll_reply_enabled;
     
     int socket_fd;
-    TaskHandle_t task_handle;
     
     artnet_dmx_callback_t dmx_callback;
     void *dmx_callback_user_data;
+    artnet_sync_callback_t sync_callback;
+    void *sync_callback_user_data;
     
     artnet_stats_t stats;
-    uint8_t last_sequence[ARTNET_MAX_UNIVERSES];  // Track sequence per universe
+    uint32_t last_dmx_ip;          // Controller allowed to sync
+    sequence_tracker_t sequence;   // Per-source sequence (receive task only)
+    
+    // ArtPollReply
+    artnet_poll_reply_packet_t poll_replies[ARTNET_MAX_BIND_INDEXES]; // Cached (timer task only)
+    uint8_t poll_reply_count;      // Replies per poll, one per bind index
+    atomic_bool poll_reply_stale;  // Rebuild before the next send
+    uint16_t node_report_counter;  // NodeReport counter
+    esp_timer_handle_t poll_timer; // Deferred reply
+    struct sockaddr_in poll_queue[ARTNET_POLL_QUEUE_SIZE]; // Pollers to answer (mutex)
+    uint8_t poll_queue_count;
+    poll_source_t poll_sources[ARTNET_POLL_SOURCES]; // Rate limit (receive task only)
     
     SemaphoreHandle_t mutex;
 } artnet_state = {
@@ -68,14 +112,17 @@ static struct {
 };
 
 // Forward declarations
-static void artnet_receive_task(void *arg);
+static void artnet_handle_datagram(const uint8_t *data, size_t length,
+                                   const struct sockaddr_in *src_addr, void *user_data);
 static esp_err_t process_artnet_packet(const uint8_t *buffer, size_t length, 
                                        const struct sockaddr_in *src_addr);
-static esp_err_t process_artdmx(const artnet_dmx_packet_t *packet,
+static esp_err_t process_artdmx(const artnet_dmx_packet_t *packet, size_t packet_length,
                                 const struct sockaddr_in *src_addr);
+static void process_artsync(const struct sockaddr_in *src_addr);
 static esp_err_t process_artpoll(const artnet_poll_packet_t *packet, 
                                  const struct sockaddr_in *src_addr);
-static esp_err_t send_artpoll_reply(const struct sockaddr_in *dest_addr);
+static void poll_reply_timer_callback(void *arg);
+static void build_artpoll_replies(void);
 
 /**
  * @brief Validate Art-Net header
@@ -122,9 +169,25 @@ esp_err_t artnet_receiver_init(void)
         return ESP_ERR_NO_MEM;
     }
     
+    // Replies are sent from the esp_timer task, never the receive task
+    const esp_timer_create_args_t timer_args = {
+        .callback = poll_reply_timer_callback,
+        .name = "artpoll_reply",
+    };
+    if (esp_timer_create(&timer_args, &artnet_state.poll_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create poll reply timer");
+        vSemaphoreDelete(artnet_state.mutex);
+        artnet_state.mutex = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
     // Initialize statistics
     memset(&artnet_state.stats, 0, sizeof(artnet_stats_t));
-    memset(artnet_state.last_sequence, 0, sizeof(artnet_state.last_sequence));
+    sequence_tracker_init(&artnet_state.sequence, SEQUENCE_MODE_ARTNET,
+                          ARTNET_SEQUENCE_TIMEOUT_MS);
+    memset(artnet_state.poll_sources, 0, sizeof(artnet_state.poll_sources));
+    artnet_state.poll_queue_count = 0;
+    atomic_store(&artnet_state.poll_reply_stale, true);
     
     artnet_state.initialized = true;
     ESP_LOGI(TAG, "Art-Net receiver initialized successfully");
@@ -145,6 +208,11 @@ esp_err_t artnet_receiver_deinit(void)
         artnet_receiver_stop();
     }
     
+    if (artnet_state.poll_timer) {
+        esp_timer_delete(artnet_state.poll_timer);
+        artnet_state.poll_timer = NULL;
+    }
+    
     // Delete mutex
     if (artnet_state.mutex) {
         vSemaphoreDelete(artnet_state.mutex);
@@ -184,13 +252,6 @@ esp_err_t artnet_receiver_start(void)
     int opt = 1;
     setsockopt(artnet_state.socket_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
     
-    // Set receive timeout
-    struct timeval timeout = {
-        .tv_sec = ARTNET_RECEIVE_TIMEOUT_MS / 1000,
-        .tv_usec = (ARTNET_RECEIVE_TIMEOUT_MS % 1000) * 1000
-    };
-    setsockopt(artnet_state.socket_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-    
     // Bind to Art-Net port
     struct sockaddr_in addr = {
         .sin_family = AF_INET,
@@ -206,19 +267,10 @@ esp_err_t artnet_receiver_start(void)
         return ESP_FAIL;
     }
     
-    // Create receiver task
-    BaseType_t ret = xTaskCreatePinnedToCore(
-        artnet_receive_task,
-        "artnet_rx",
-        ARTNET_TASK_STACK_SIZE,
-        NULL,
-        ARTNET_TASK_PRIORITY,
-        &artnet_state.task_handle,
-        ARTNET_TASK_CORE
-    );
-    
-    if (ret != pdPASS) {
-        ESP_LOGE(TAG, "Failed to create receiver task");
+    // Datagrams are received and batched by the shared dispatcher task
+    esp_err_t ret = udp_dispatcher_register(artnet_state.socket_fd, artnet_handle_datagram, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register socket: %s", esp_err_to_name(ret));
         close(artnet_state.socket_fd);
         artnet_state.socket_fd = -1;
         xSemaphoreGive(artnet_state.mutex);
@@ -250,21 +302,18 @@ esp_err_t artnet_receiver_stop(void)
     
     artnet_state.running = false;
     
-    // Close socket (this will unblock the receive task)
+    // Pending replies are dropped; a timer run already waiting finds no socket
+    esp_timer_stop(artnet_state.poll_timer);
+    artnet_state.poll_queue_count = 0;
+    
+    // The dispatcher closes the socket once it stops waiting on it
     if (artnet_state.socket_fd >= 0) {
-        close(artnet_state.socket_fd);
+        udp_dispatcher_unregister(artnet_state.socket_fd);
         artnet_state.socket_fd = -1;
     }
     
     xSemaphoreGive(artnet_state.mutex);
     
-    // Wait for task to terminate
-    if (artnet_state.task_handle) {
-        // Task will delete itself
-        vTaskDelay(pdMS_TO_TICKS(100));
-        artnet_state.task_handle = NULL;
-    }
-    
     ESP_LOGI(TAG, "Art-Net receiver stopped");
     
     return ESP_OK;
@@ -290,6 +339,26 @@ esp_err_t artnet_receiver_set_callback(artnet_dmx_callback_t callback, void *use
     return ESP_OK;
 }
 
+esp_err_t artnet_receiver_set_sync_callback(artnet_sync_callback_t callback, void *user_data)
+{
+    if (!artnet_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(artnet_state.mutex, portMAX_DELAY);
+    artnet_state.sync_callback = callback;
+    artnet_state.sync_callback_user_data = user_data;
+    xSemaphoreGive(artnet_state.mutex);
+    
+    ESP_LOGI(TAG, "Sync callback registered");
+    
+    return ESP_OK;
+}
+
 esp_err_t artnet_receiver_get_stats(artnet_stats_t *stats)
 {
     if (!artnet_state.initialized) {
@@ -307,6 +376,20 @@ esp_err_t artnet_receiver_get_stats(artnet_stats_t *stats)
     return ESP_OK;
 }
 
+uint8_t artnet_receiver_get_source_stats(sequence_source_stats_t *sources,
+                                         uint8_t max_sources)
+{
+    if (!artnet_state.initialized || !sources) {
+        return 0;
+    }
+    
+    xSemaphoreTake(artnet_state.mutex, portMAX_DELAY);
+    uint8_t count = sequence_tracker_get_sources(&artnet_state.sequence, sources, max_sources);
+    xSemaphoreGive(artnet_state.mutex);
+    
+    return count;
+}
+
 esp_err_t artnet_receiver_enable_poll_reply(bool enable)
 {
     if (!artnet_state.initialized) {
@@ -322,6 +405,17 @@ esp_err_t artnet_receiver_enable_poll_reply(bool enable)
     return ESP_OK;
 }
 
+esp_err_t artnet_receiver_refresh_poll_reply(void)
+{
+    if (!artnet_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    atomic_store(&artnet_state.poll_reply_stale, true);
+    
+    return ESP_OK;
+}
+
 bool artnet_receiver_is_running(void)
 {
     return artnet_state.running;
@@ -332,52 +426,19 @@ bool artnet_receiver_is_running(void)
 // ============================================================================
 
 /**
- * @brief Art-Net receiver task
+ * @brief Handle one datagram from the dispatcher task
  */
-static void artnet_receive_task(void *arg)
+static void artnet_handle_datagram(const uint8_t *data, size_t length,
+                                   const struct sockaddr_in *src_addr, void *user_data)
 {
-    uint8_t buffer[ARTNET_MAX_PACKET_SIZE];
-    struct sockaddr_in src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
-    
-    ESP_LOGI(TAG, "Art-Net receiver task started");
+    // Update statistics
+    artnet_state.stats.packets_received++;
     
-    while (artnet_state.running) {
-        // Receive packet
-        int len = recvfrom(artnet_state.socket_fd, buffer, sizeof(buffer), 0,
-                          (struct sockaddr *)&src_addr, &src_addr_len);
-        
-        if (len < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // Timeout, continue
-                continue;
-            }
-            
-            if (!artnet_state.running) {
-                // Socket closed, exit
-                break;
-            }
-            
-            ESP_LOGW(TAG, "Receive error: %d", errno);
-            continue;
-        }
-        
-        if (len == 0) {
-            continue;
-        }
-        
-        // Update statistics
-        artnet_state.stats.packets_received++;
-        
-        // Process packet
-        esp_err_t ret = process_artnet_packet(buffer, len, &src_addr);
-        if (ret != ESP_OK) {
-            artnet_state.stats.invalid_packets++;
-        }
+    // Process packet
+    esp_err_t ret = process_artnet_packet(data, length, src_addr);
+    if (ret != ESP_OK) {
+        artnet_state.stats.invalid_packets++;
     }
-    
-    ESP_LOGI(TAG, "Art-Net receiver task stopped");
-    vTaskDelete(NULL);
 }
 
 /**
@@ -396,9 +457,23 @@ static esp_err_t process_artnet_packet(const uint8_t *buffer, size_t length,
     
     switch (opcode) {
         case ARTNET_OP_DMX:
-            if (length >= sizeof(artnet_dmx_packet_t)) {
+            // Short universes are allowed; the data length is checked against the packet
+            if (length >= ARTNET_DMX_HEADER_SIZE) {
+                // Drop universes no port outputs before touching the payload
+                uint16_t universe = ((const artnet_dmx_packet_t *)buffer)->universe &
+                                    ARTNET_PORT_ADDRESS_MAX;
+                if (!universe_router_is_routed(ROUTER_PROTOCOL_ARTNET, universe)) {
+                    artnet_state.stats.unrouted_packets++;
+                    return ESP_OK;
+                }
                 artnet_state.stats.dmx_packets++;
-                return process_artdmx((const artnet_dmx_packet_t *)buffer, src_addr);
+                return process_artdmx((const artnet_dmx_packet_t *)buffer, length, src_addr);
+            }
+            break;
+            
+        case ARTNET_OP_SYNC:
+            if (length >= sizeof(artnet_sync_packet_t)) {
+                process_artsync(src_addr);
             }
             break;
             
@@ -420,32 +495,39 @@ static esp_err_t process_artnet_packet(const uint8_t *buffer, size_t length,
 /**
  * @brief Process ArtDmx packet
  */
-static esp_err_t process_artdmx(const artnet_dmx_packet_t *packet,
+static esp_err_t process_artdmx(const artnet_dmx_packet_t *packet, size_t packet_length,
                                 const struct sockaddr_in *src_addr)
 {
-    // Extract universe (little endian)
-    uint16_t universe = packet->universe;
+    // Extract the 15-bit Port-Address (SubUni low byte, Net high byte)
+    uint16_t universe = packet->universe & ARTNET_PORT_ADDRESS_MAX;
     
     // Extract length (big endian / network byte order)
     uint16_t length = artnet_ntohs(packet->length);
     
-    // Validate length
-    if (length < 2 || length > 512) {
+    // Validate length (must also fit in what was received)
+    if (length < 2 || length > 512 || (size_t)ARTNET_DMX_HEADER_SIZE + length > packet_length) {
         return ESP_FAIL;
     }
     
-    // Check sequence number (optional - for statistics)
+    // Extract source IP address
+    uint32_t source_ip = src_addr->sin_addr.s_addr;
+    
+    // Late or repeated frames (reordered on WiFi) would flicker the output
     uint8_t sequence = packet->sequence;
-    if (universe < ARTNET_MAX_UNIVERSES) {
-        uint8_t expected = artnet_state.last_sequence[universe] + 1;
-        if (sequence != expected && artnet_state.last_sequence[universe] != 0) {
-            artnet_state.stats.sequence_errors++;
+    uint8_t source_id[SEQUENCE_SOURCE_ID_LENGTH] = {0};
+    memcpy(source_id, &source_ip, sizeof(source_ip));
+    sequence_result_t result = sequence_tracker_check(&artnet_state.sequence, source_id,
+                                                      universe, 0, sequence,
+                                                      esp_timer_get_time());
+    if (result != SEQUENCE_ACCEPT) {
+        artnet_state.stats.sequence_errors++;
+        if (result != SEQUENCE_GAP) {
+            artnet_state.stats.sequence_drops++;
+            return ESP_OK;
         }
-        artnet_state.last_sequence[universe] = sequence;
     }
     
-    // Extract source IP address
-    uint32_t source_ip = src_addr->sin_addr.s_addr;
+    artnet_state.last_dmx_ip = source_ip;
     
     // Call callback if registered
     if (artnet_state.dmx_callback) {
@@ -456,31 +538,204 @@ static esp_err_t process_artdmx(const artnet_dmx_packet_t *packet,
     return ESP_OK;
 }
 
+/**
+ * @brief Process ArtSync packet
+ * 
+ * Only the controller sending ArtDmx may sync; ArtSync from anyone else is
+ * ignored (Art-Net 4, ArtSync).
+ */
+static void process_artsync(const struct sockaddr_in *src_addr)
+{
+    uint32_t source_ip = src_addr->sin_addr.s_addr;
+    
+    if (source_ip != artnet_state.last_dmx_ip) {
+        artnet_state.stats.sync_ignored++;
+        return;
+    }
+    
+    artnet_state.stats.sync_packets++;
+    
+    if (artnet_state.sync_callback) {
+        artnet_state.sync_callback(source_ip, artnet_state.sync_callback_user_data);
+    }
+}
+
+/**
+ * @brief Check the poll rate of a controller (receive task only)
+ * 
+ * @return true if the controller may be answered now
+ */
+static bool poll_rate_allowed(uint32_t ip, uint32_t now_ms)
+{
+    for (int i = 0; i < ARTNET_POLL_SOURCES; i++) {
+        const poll_source_t *source = &artnet_state.poll_sources[i];
+        if (source->ip == ip) {
+            return now_ms - source->last_reply_ms >= ARTNET_POLL_MIN_INTERVAL_MS;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Record that a controller's poll was queued for a reply (receive task only)
+ */
+static void poll_rate_record(uint32_t ip, uint32_t now_ms)
+{
+    poll_source_t *oldest = &artnet_state.poll_sources[0];
+    
+    for (int i = 0; i < ARTNET_POLL_SOURCES; i++) {
+        poll_source_t *source = &artnet_state.poll_sources[i];
+        if (source->ip == ip) {
+            source->last_reply_ms = now_ms;
+            return;
+        }
+        if (now_ms - source->last_reply_ms > now_ms - oldest->last_reply_ms) {
+            oldest = source;
+        }
+    }
+    
+    // New controller: take over the slot answered longest ago
+    oldest->ip = ip;
+    oldest->last_reply_ms = now_ms;
+}
+
 /**
  * @brief Process ArtPoll packet
+ * 
+ * Only queues the poller; the reply is sent by the timer after a random
+ * delay of up to ARTNET_POLL_REPLY_MAX_DELAY_MS.
  */
 static esp_err_t process_artpoll(const artnet_poll_packet_t *packet,
                                  const struct sockaddr_in *src_addr)
 {
-    // Send ArtPollReply if enabled
-    if (artnet_state.poll_reply_enabled) {
-        return send_artpoll_reply(src_addr);
+    if (!artnet_state.poll_reply_enabled) {
+        return ESP_OK;
+    }
+    
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    if (!poll_rate_allowed(src_addr->sin_addr.s_addr, now_ms)) {
+        artnet_state.stats.poll_rate_limited++;
+        return ESP_OK;
+    }
+    
+    xSemaphoreTake(artnet_state.mutex, portMAX_DELAY);
+    
+    bool queued = artnet_state.poll_queue_count < ARTNET_POLL_QUEUE_SIZE;
+    if (!queued) {
+        artnet_state.stats.poll_rate_limited++;
+    } else {
+        artnet_state.poll_queue[artnet_state.poll_queue_count++] = *src_addr;
+        
+        // The first queued poll arms the timer; later ones ride along
+        if (artnet_state.poll_queue_count == 1) {
+            uint64_t delay_us = (uint64_t)(esp_random() % (ARTNET_POLL_REPLY_MAX_DELAY_MS + 1)) * 1000;
+            esp_timer_start_once(artnet_state.poll_timer, delay_us);
+        }
+    }
+    
+    xSemaphoreGive(artnet_state.mutex);
+    
+    // Only a poll that will be answered counts against the controller
+    if (queued) {
+        poll_rate_record(src_addr->sin_addr.s_addr, now_ms);
     }
     
     return ESP_OK;
 }
 
 /**
- * @brief Send ArtPollReply packet
+ * @brief Send the cached ArtPollReplies to every queued poller (esp_timer task)
  */
-static esp_err_t send_artpoll_reply(const struct sockaddr_in *dest_addr)
+static void poll_reply_timer_callback(void *arg)
 {
-    artnet_poll_reply_packet_t reply;
-    memset(&reply, 0, sizeof(reply));
+    // Only this callback touches the cached replies, so they are rebuilt unlocked
+    if (atomic_exchange(&artnet_state.poll_reply_stale, false)) {
+        build_artpoll_replies();
+        artnet_state.stats.poll_reply_rebuilds++;
+    }
+    
+    xSemaphoreTake(artnet_state.mutex, portMAX_DELAY);
+    
+    for (int i = 0; i < artnet_state.poll_queue_count && artnet_state.socket_fd >= 0; i++) {
+        const struct sockaddr_in *dest_addr = &artnet_state.poll_queue[i];
+        
+        for (int r = 0; r < artnet_state.poll_reply_count; r++) {
+            artnet_poll_reply_packet_t *reply = &artnet_state.poll_replies[r];
+            
+            // NodeReport counter: four decimal digits, wrapping at 10000
+            uint16_t count = artnet_state.node_report_counter;
+            artnet_state.node_report_counter = (count + 1) % 10000;
+            char *digits = &reply->node_report[ARTNET_NODE_REPORT_COUNTER_OFFSET];
+            for (int d = 3; d >= 0; d--) {
+                digits[d] = '0' + count % 10;
+                count /= 10;
+            }
+            
+            int sent = sendto(artnet_state.socket_fd, reply, sizeof(*reply), 0,
+                              (const struct sockaddr *)dest_addr, sizeof(*dest_addr));
+            if (sent < 0) {
+                ESP_LOGW(TAG, "Failed to send ArtPollReply: %d", errno);
+                continue;
+            }
+            
+            artnet_state.stats.poll_replies_sent++;
+        }
+        
+        ESP_LOGD(TAG, "Sent %d ArtPollReply to %s:%d", artnet_state.poll_reply_count,
+                 inet_ntoa(dest_addr->sin_addr), ntohs(dest_addr->sin_port));
+    }
+    artnet_state.poll_queue_count = 0;
+    
+    xSemaphoreGive(artnet_state.mutex);
+}
+
+/**
+ * @brief List the outputs to announce, from the routing table
+ * 
+ * Each port contributes its primary universe, then its secondary.
+ * 
+ * @param ports Output array (ARTNET_MAX_BIND_INDEXES entries)
+ * @return Number of outputs
+ */
+static uint8_t collect_node_ports(node_port_t *ports)
+{
+    uint8_t count = 0;
+    
+    for (uint8_t port = 1; port <= UNIVERSE_ROUTER_PORTS; port++) {
+        uint16_t addresses[UNIVERSE_ROUTER_PORT_UNIVERSES];
+        uint8_t n = universe_router_get_port_universes(ROUTER_PROTOCOL_ARTNET, port,
+                                                      addresses, UNIVERSE_ROUTER_PORT_UNIVERSES);
+        for (int i = 0; i < n; i++) {
+            if (count >= ARTNET_MAX_BIND_INDEXES) {
+                ESP_LOGW(TAG, "Port %d Port-Address %u not announced, %d bind indexes in use",
+                         port, addresses[i], ARTNET_MAX_BIND_INDEXES);
+                continue;
+            }
+            ports[count].dmx_port = port;
+            ports[count].address = addresses[i];
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Build the ArtPollReplies from the current IP, MAC and configuration
+ * 
+ * One reply per output, each with a single port and its own bind index, so
+ * every output carries its own Net and Sub-Net. A node without outputs
+ * still answers with one reply announcing no ports.
+ */
+static void build_artpoll_replies(void)
+{
+    artnet_poll_reply_packet_t *reply = &artnet_state.poll_replies[0];
+    memset(reply, 0, sizeof(*reply));
     
     // Fill header
-    memcpy(reply.id, ARTNET_HEADER, 8);
-    reply.opcode = ARTNET_OP_POLL_REPLY;
+    memcpy(reply->id, ARTNET_HEADER, 8);
+    reply->opcode = ARTNET_OP_POLL_REPLY;
     
     // Get IP address
     esp_netif_t *netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
@@ -491,68 +746,63 @@ static esp_err_t send_artpoll_reply(const struct sockaddr_in *dest_addr)
     if (netif) {
         esp_netif_ip_info_t ip_info;
         if (esp_netif_get_ip_info(netif, &ip_info) == ESP_OK) {
-            reply.ip[0] = (ip_info.ip.addr >> 0) & 0xFF;
-            reply.ip[1] = (ip_info.ip.addr >> 8) & 0xFF;
-            reply.ip[2] = (ip_info.ip.addr >> 16) & 0xFF;
-            reply.ip[3] = (ip_info.ip.addr >> 24) & 0xFF;
+            reply->ip[0] = (ip_info.ip.addr >> 0) & 0xFF;
+            reply->ip[1] = (ip_info.ip.addr >> 8) & 0xFF;
+            reply->ip[2] = (ip_info.ip.addr >> 16) & 0xFF;
+            reply->ip[3] = (ip_info.ip.addr >> 24) & 0xFF;
         }
     }
     
     // Port
-    reply.port = htons(ARTNET_PORT);
+    reply->port = htons(ARTNET_PORT);
     
     // Version info
-    reply.version_info = htons(0x0001);  // Version 0.1
+    reply->version_info = htons(0x0001);  // Version 0.1
     
     // Get node names from config
     config_t *config = config_get();
     if (config) {
-        strncpy(reply.short_name, config->node_info.short_name, sizeof(reply.short_name) - 1);
-        strncpy(reply.long_name, config->node_info.long_name, sizeof(reply.long_name) - 1);
+        strncpy(reply->short_name, config->node_info.short_name, sizeof(reply->short_name) - 1);
+        strncpy(reply->long_name, config->node_info.long_name, sizeof(reply->long_name) - 1);
     }
     
-    // Node report
-    snprintf(reply.node_report, sizeof(reply.node_report), "#0001 [%04ld] OK",
-             artnet_state.stats.dmx_packets);
-    
-    // Number of ports
-    reply.num_ports = htons(2);  // 2 DMX ports
-    
-    // Port types (DMX output)
-    reply.port_types[0] = 0x80;  // DMX512 output
-    reply.port_types[1] = 0x80;  // DMX512 output
-    
-    // Output universe mapping
-    if (config) {
-        reply.swout[0] = config->port1.universe_primary & 0x0F;
-        reply.swout[1] = config->port2.universe_primary & 0x0F;
-    }
+    // Node report (the counter is filled in per reply)
+    strncpy(reply->node_report, "#0001 [0000] OK", sizeof(reply->node_report) - 1);
     
     // Status
-    reply.status1 = 0xE0;  // Indicators normal, network configured
-    reply.status2 = 0x08;  // Supports ArtNet 4
+    reply->status1 = 0xE0;  // Indicators normal, network configured
+    reply->status2 = 0x08;  // Supports ArtNet 4
     
     // Style
-    reply.style = 0x00;  // ST_NODE (DMX to/from Art-Net device)
+    reply->style = 0x00;  // ST_NODE (DMX to/from Art-Net device)
     
     // MAC address
     uint8_t mac[6];
     if (netif && esp_netif_get_mac(netif, mac) == ESP_OK) {
-        memcpy(reply.mac, mac, 6);
+        memcpy(reply->mac, mac, 6);
     }
     
-    // Send reply
-    int sent = sendto(artnet_state.socket_fd, &reply, sizeof(reply), 0,
-                     (struct sockaddr *)dest_addr, sizeof(*dest_addr));
+    // Bind address: the root device itself
+    memcpy(reply->bind_ip, reply->ip, sizeof(reply->bind_ip));
+    reply->bind_index = 1;
     
-    if (sent < 0) {
-        ESP_LOGW(TAG, "Failed to send ArtPollReply: %d", errno);
-        return ESP_FAIL;
-    }
+    // One reply per output, copied from the common part built above
+    node_port_t ports[ARTNET_MAX_BIND_INDEXES];
+    uint8_t num_ports = collect_node_ports(ports);
     
-    artnet_state.stats.poll_replies_sent++;
-    ESP_LOGD(TAG, "Sent ArtPollReply to %s:%d",
-             inet_ntoa(dest_addr->sin_addr), ntohs(dest_addr->sin_port));
+    for (int i = 0; i < num_ports; i++) {
+        reply = &artnet_state.poll_replies[i];
+        if (i > 0) {
+            *reply = artnet_state.poll_replies[0];
+        }
+        
+        reply->bind_index = i + 1;
+        reply->num_ports = htons(1);
+        reply->net_switch = ARTNET_NET(ports[i].address);
+        reply->sub_switch = ARTNET_SUB_NET(ports[i].address);
+        reply->port_types[0] = 0x80;  // DMX512 output
+        reply->swout[0] = ARTNET_UNIVERSE(ports[i].address);
+    }
     
-    return ESP_OK;
+    artnet_state.poll_reply_count = num_ports > 0 ? num_ports : 1;
 }
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "esp_err.h"
+#include "sequence_tracker.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,10 +21,12 @@ extern "C" {
  * Broadcast: 2.255.255.255 or 10.255.255.255
  * 
  * Features:
- * - Receives ArtDmx packets with DMX512 data
- * - Responds to ArtPoll discovery requests
- * - Universe routing (0-32767)
- * - Sequence number tracking
+ * - Receives ArtDmx packets with DMX512 data (2-512 channels)
+ * - Responds to ArtPoll discovery requests with cached ArtPollReplies, sent
+ *   after a random 0-1 s delay and rate limited per controller
+ * - One ArtPollReply per output universe, each with its own bind index
+ * - Universe routing by 15-bit Port-Address (Net / Sub-Net / Universe)
+ * - Per-source sequence tracking: late and duplicate packets are dropped
  * - Source tracking
  */
 
@@ -31,7 +34,6 @@ extern "C" {
 #define ARTNET_PORT 6454
 #define ARTNET_HEADER "Art-Net\0"
 #define ARTNET_PROTOCOL_VERSION 14
-#define ARTNET_MAX_UNIVERSES 4  // Maximum universes to track
 
 // Art-Net OpCodes
 #define ARTNET_OP_POLL        0x2000
@@ -40,6 +42,17 @@ extern "C" {
 #define ARTNET_OP_ADDRESS     0x6000
 #define ARTNET_OP_SYNC        0x5200
 
+// Without an ArtSync for this long, nodes return to immediate output
+#define ARTNET_SYNC_TIMEOUT_MS 4000
+
+// ArtDmx header size (everything before the data field)
+#define ARTNET_DMX_HEADER_SIZE 18
+
+// ArtPollReply scheduling
+#define ARTNET_POLL_REPLY_MAX_DELAY_MS 1000 // Random reply delay, 0 to this (Art-Net 4)
+#define ARTNET_POLL_MIN_INTERVAL_MS    1000 // Polls from one controller faster than this go unanswered
+#define ARTNET_MAX_BIND_INDEXES        4    // Outputs announced, one ArtPollReply each
+
 /**
  * @brief Art-Net DMX packet structure
  */
@@ -67,6 +80,18 @@ typedef struct __attribute__((packed)) {
     uint8_t priority;        /**< Diagnostics priority */
 } artnet_poll_packet_t;
 
+/**
+ * @brief Art-Net Sync packet structure
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t id[8];           /**< "Art-Net\0" */
+    uint16_t opcode;         /**< OpCode (0x5200 for ArtSync) */
+    uint8_t prot_ver_hi;     /**< Protocol version high byte */
+    uint8_t prot_ver_lo;     /**< Protocol version low byte */
+    uint8_t aux1;            /**< Transmit as zero */
+    uint8_t aux2;            /**< Transmit as zero */
+} artnet_sync_packet_t;
+
 /**
  * @brief Art-Net PollReply packet structure
  */
@@ -111,14 +136,20 @@ typedef struct {
     uint32_t dmx_packets;         /**< DMX packets received */
     uint32_t poll_packets;        /**< Poll packets received */
     uint32_t poll_replies_sent;   /**< Poll replies sent */
+    uint32_t poll_rate_limited;   /**< Polls left unanswered (too frequent or queue full) */
+    uint32_t poll_reply_rebuilds; /**< Times the cached ArtPollReply was rebuilt */
     uint32_t invalid_packets;     /**< Invalid packets */
-    uint32_t sequence_errors;     /**< Sequence number errors */
+    uint32_t sequence_errors;     /**< Packets out of sequence (gaps and drops) */
+    uint32_t sequence_drops;      /**< Late or duplicate packets discarded */
+    uint32_t unrouted_packets;    /**< DMX packets for universes no port outputs */
+    uint32_t sync_packets;        /**< ArtSync packets acted on */
+    uint32_t sync_ignored;        /**< ArtSync packets from another controller */
 } artnet_stats_t;
 
 /**
  * @brief Art-Net DMX callback
  * @param universe Universe number (0-32767)
- * @param data DMX data (512 channels)
+ * @param data DMX data (only the first length channels are valid)
  * @param length Data length (actual length, 2-512)
  * @param sequence Sequence number
  * @param source_ip Source IP address (network byte order)
@@ -128,6 +159,16 @@ typedef void (*artnet_dmx_callback_t)(uint16_t universe, const uint8_t *data,
                                        uint16_t length, uint8_t sequence,
                                        uint32_t source_ip, void *user_data);
 
+/**
+ * @brief Art-Net sync callback
+ * 
+ * Called for each ArtSync from the controller that sent the latest ArtDmx.
+ * 
+ * @param source_ip Source IP address (network byte order)
+ * @param user_data User data pointer
+ */
+typedef void (*artnet_sync_callback_t)(uint32_t source_ip, void *user_data);
+
 /**
  * @brief Initialize Art-Net receiver
  * 
@@ -153,8 +194,8 @@ esp_err_t artnet_receiver_deinit(void);
 /**
  * @brief Start Art-Net receiver
  * 
- * Starts the UDP receiver task on port 6454.
- * Receiver must be initialized first.
+ * Binds UDP port 6454 and hands the socket to the UDP dispatcher.
+ * Receiver and UDP dispatcher must be initialized first.
  * 
  * @return
  *     - ESP_OK on success
@@ -166,7 +207,7 @@ esp_err_t artnet_receiver_start(void);
 /**
  * @brief Stop Art-Net receiver
  * 
- * Stops the receiver task and closes the socket.
+ * Hands the socket back to the UDP dispatcher, which closes it.
  * 
  * @return
  *     - ESP_OK on success
@@ -188,6 +229,21 @@ esp_err_t artnet_receiver_stop(void);
  */
 esp_err_t artnet_receiver_set_callback(artnet_dmx_callback_t callback, void *user_data);
 
+/**
+ * @brief Register ArtSync callback
+ * 
+ * ArtSync packets are ignored unless they come from the IP that sent the
+ * most recent ArtDmx, as the Art-Net spec requires.
+ * 
+ * @param callback Callback function
+ * @param user_data User data pointer passed to callback
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if callback is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t artnet_receiver_set_sync_callback(artnet_sync_callback_t callback, void *user_data);
+
 /**
  * @brief Get receiver statistics
  * 
@@ -201,6 +257,18 @@ esp_err_t artnet_receiver_set_callback(artnet_dmx_callback_t callback, void *use
  */
 esp_err_t artnet_receiver_get_stats(artnet_stats_t *stats);
 
+/**
+ * @brief Get per-source sequence statistics
+ * 
+ * One entry per (source IP, universe) stream seen recently.
+ * 
+ * @param sources Output array
+ * @param max_sources Size of output array
+ * @return Number of streams written
+ */
+uint8_t artnet_receiver_get_source_stats(sequence_source_stats_t *sources,
+                                         uint8_t max_sources);
+
 /**
  * @brief Enable or disable ArtPollReply responses
  * 
@@ -214,6 +282,18 @@ esp_err_t artnet_receiver_get_stats(artnet_stats_t *stats);
  */
 esp_err_t artnet_receiver_enable_poll_reply(bool enable);
 
+/**
+ * @brief Mark the cached ArtPollReply out of date
+ * 
+ * The reply is rebuilt before it is next sent. Call after the IP address,
+ * the configuration or the node status changes.
+ * 
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t artnet_receiver_refresh_poll_reply(void);
+
 /**
  * @brief Check if receiver is running
  * 
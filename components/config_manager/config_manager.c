@@ -2,6 +2,7 @@
 #include "storage_manager.h"
 #include "esp_log.h"
 #include "cJSON.h"
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "config";
@@ -10,6 +11,177 @@ static const char *CONFIG_FILE = "config.json";
 // Global configuration
 static config_t g_config;
 
+// Channel-mode map entry of a channel without a range of its own
+#define CHANNEL_MODE_DEFAULT 0xFF
+
+/**
+ * @brief Add the Art-Net Net / Sub-Net / Universe split of a port's primary universe
+ */
+static void add_port_address(cJSON *port, const port_config_t *cfg)
+{
+    uint16_t address = cfg->universe_primary & ARTNET_PORT_ADDRESS_MAX;
+    cJSON_AddNumberToObject(port, "artnet_net", ARTNET_NET(address));
+    cJSON_AddNumberToObject(port, "artnet_sub_net", ARTNET_SUB_NET(address));
+    cJSON_AddNumberToObject(port, "artnet_universe", ARTNET_UNIVERSE(address));
+}
+
+/**
+ * @brief Set a port's primary universe from Art-Net Net / Sub-Net / Universe
+ * 
+ * Any of the three fields may be given; the others keep their current value.
+ */
+static void parse_port_address(cJSON *port, port_config_t *cfg)
+{
+    uint16_t address = cfg->universe_primary & ARTNET_PORT_ADDRESS_MAX;
+    uint8_t net = ARTNET_NET(address);
+    uint8_t sub_net = ARTNET_SUB_NET(address);
+    uint8_t universe = ARTNET_UNIVERSE(address);
+    bool changed = false;
+    cJSON *item;
+    
+    if ((item = cJSON_GetObjectItem(port, "artnet_net"))) {
+        net = item->valueint;
+        changed = true;
+    }
+    if ((item = cJSON_GetObjectItem(port, "artnet_sub_net"))) {
+        sub_net = item->valueint;
+        changed = true;
+    }
+    if ((item = cJSON_GetObjectItem(port, "artnet_universe"))) {
+        universe = item->valueint;
+        changed = true;
+    }
+    
+    if (changed) {
+        cfg->universe_primary = ARTNET_PORT_ADDRESS(net, sub_net, universe);
+    }
+}
+
+/**
+ * @brief Add a port's channel-mode map as DMX address ranges
+ */
+static void add_channel_modes(cJSON *port, const port_config_t *cfg)
+{
+    cJSON *ranges = cJSON_CreateArray();
+    for (int i = 0; i < cfg->channel_mode_count; i++) {
+        const channel_mode_range_t *range = &cfg->channel_modes[i];
+        cJSON *entry = cJSON_CreateObject();
+        cJSON_AddNumberToObject(entry, "address", range->start + 1);
+        cJSON_AddNumberToObject(entry, "count", range->count);
+        cJSON_AddNumberToObject(entry, "mode", range->mode);
+        cJSON_AddItemToArray(ranges, entry);
+    }
+    cJSON_AddItemToObject(port, "channel_modes", ranges);
+}
+
+/**
+ * @brief Set the mode of DMX addresses [address, address + count) in a map
+ * 
+ * Addresses are 1-based; anything outside the universe is ignored.
+ */
+static void fill_channel_modes(uint8_t *map, int address, int count, int mode)
+{
+    if (mode < MERGE_MODE_HTP || mode > MERGE_MODE_LATEST) {
+        ESP_LOGW(TAG, "Invalid channel merge mode %d ignored", mode);
+        return;
+    }
+    
+    for (int ch = address - 1; ch < address - 1 + count && ch < 512; ch++) {
+        if (ch >= 0) {
+            map[ch] = mode;
+        }
+    }
+}
+
+/**
+ * @brief Encode a 512-entry mode map as ranges of equal mode
+ */
+static void encode_channel_modes(const uint8_t *map, port_config_t *cfg)
+{
+    cfg->channel_mode_count = 0;
+    
+    for (int ch = 0; ch < 512; ) {
+        int start = ch;
+        while (ch < 512 && map[ch] == map[start]) {
+            ch++;
+        }
+        if (map[start] == CHANNEL_MODE_DEFAULT) {
+            continue;
+        }
+        
+        if (cfg->channel_mode_count >= CONFIG_MAX_CHANNEL_MODE_RANGES) {
+            ESP_LOGW(TAG, "More than %d channel mode ranges, channels from %d use the port mode",
+                     CONFIG_MAX_CHANNEL_MODE_RANGES, start + 1);
+            return;
+        }
+        
+        channel_mode_range_t *range = &cfg->channel_modes[cfg->channel_mode_count++];
+        range->start = start;
+        range->count = ch - start;
+        range->mode = map[start];
+    }
+}
+
+/**
+ * @brief Read a port's channel-mode map
+ * 
+ * "channel_modes": [{"address", "count", "mode"}] sets ranges directly.
+ * "fixtures": [{"address", "footprint", "mode", "htp": [...]}] patches
+ * fixtures: the footprint uses mode (LATEST if omitted), except the fixture
+ * channels listed in htp (1-based, e.g. intensity), which use HTP. Fixtures
+ * are applied after the ranges. Either key replaces the whole map.
+ */
+static void parse_channel_modes(cJSON *port, port_config_t *cfg)
+{
+    cJSON *ranges = cJSON_GetObjectItem(port, "channel_modes");
+    cJSON *fixtures = cJSON_GetObjectItem(port, "fixtures");
+    if (!cJSON_IsArray(ranges) && !cJSON_IsArray(fixtures)) {
+        return;
+    }
+    
+    uint8_t map[512];
+    memset(map, CHANNEL_MODE_DEFAULT, sizeof(map));
+    cJSON *entry;
+    cJSON *item;
+    
+    if (cJSON_IsArray(ranges)) {
+        cJSON_ArrayForEach(entry, ranges) {
+            cJSON *address = cJSON_GetObjectItem(entry, "address");
+            cJSON *count = cJSON_GetObjectItem(entry, "count");
+            cJSON *mode = cJSON_GetObjectItem(entry, "mode");
+            if (address && count && mode) {
+                fill_channel_modes(map, address->valueint, count->valueint, mode->valueint);
+            }
+        }
+    }
+    
+    if (cJSON_IsArray(fixtures)) {
+        cJSON_ArrayForEach(entry, fixtures) {
+            cJSON *address = cJSON_GetObjectItem(entry, "address");
+            cJSON *footprint = cJSON_GetObjectItem(entry, "footprint");
+            if (!address || !footprint) {
+                continue;
+            }
+            
+            int mode = MERGE_MODE_LATEST;
+            if ((item = cJSON_GetObjectItem(entry, "mode"))) {
+                mode = item->valueint;
+            }
+            fill_channel_modes(map, address->valueint, footprint->valueint, mode);
+            
+            cJSON *htp = cJSON_GetObjectItem(entry, "htp");
+            cJSON_ArrayForEach(item, htp) {
+                if (item->valueint >= 1 && item->valueint <= footprint->valueint) {
+                    fill_channel_modes(map, address->valueint + item->valueint - 1, 1,
+                                       MERGE_MODE_HTP);
+                }
+            }
+        }
+    }
+    
+    encode_channel_modes(map, cfg);
+}
+
 // Default configuration
 static void config_set_defaults(void)
 {
@@ -33,6 +205,7 @@ static void config_set_defaults(void)
     g_config.port1.universe_offset = 0;
     g_config.port1.protocol_mode = PROTOCOL_MERGE_BOTH;
     g_config.port1.merge_mode = MERGE_MODE_HTP;
+    g_config.port1.short_frame_policy = SHORT_FRAME_HOLD;
     g_config.port1.rdm_enabled = true;
     
     // Port 2 defaults
@@ -42,10 +215,13 @@ static void config_set_defaults(void)
     g_config.port2.universe_offset = 0;
     g_config.port2.protocol_mode = PROTOCOL_MERGE_BOTH;
     g_config.port2.merge_mode = MERGE_MODE_HTP;
+    g_config.port2.short_frame_policy = SHORT_FRAME_HOLD;
     g_config.port2.rdm_enabled = true;
     
     // Merge defaults
     g_config.merge.timeout_seconds = 3;
+    g_config.merge.source_pool_size = CONFIG_DEFAULT_SOURCE_POOL;
+    g_config.merge.pool_in_psram = true;
     
     // Node info defaults
     strcpy(g_config.node_info.short_name, "ArtNet-Node");
@@ -110,6 +286,22 @@ config_t* config_get(void)
     return &g_config;
 }
 
+const port_config_t* config_get_port(const config_t *config, uint8_t port)
+{
+    if (!config) {
+        return NULL;
+    }
+    
+    switch (port) {
+        case 1:
+            return &config->port1;
+        case 2:
+            return &config->port2;
+        default:
+            return NULL;
+    }
+}
+
 esp_err_t config_reset_to_defaults(void)
 {
     config_set_defaults();
@@ -154,10 +346,13 @@ esp_err_t config_to_json(char **json_str)
     cJSON *port1 = cJSON_CreateObject();
     cJSON_AddNumberToObject(port1, "mode", g_config.port1.mode);
     cJSON_AddNumberToObject(port1, "universe_primary", g_config.port1.universe_primary);
+    add_port_address(port1, &g_config.port1);
     cJSON_AddNumberToObject(port1, "universe_secondary", g_config.port1.universe_secondary);
     cJSON_AddNumberToObject(port1, "universe_offset", g_config.port1.universe_offset);
     cJSON_AddNumberToObject(port1, "protocol_mode", g_config.port1.protocol_mode);
     cJSON_AddNumberToObject(port1, "merge_mode", g_config.port1.merge_mode);
+    add_channel_modes(port1, &g_config.port1);
+    cJSON_AddNumberToObject(port1, "short_frame_policy", g_config.port1.short_frame_policy);
     cJSON_AddBoolToObject(port1, "rdm_enabled", g_config.port1.rdm_enabled);
     cJSON_AddItemToObject(root, "port1", port1);
     
@@ -165,16 +360,21 @@ esp_err_t config_to_json(char **json_str)
     cJSON *port2 = cJSON_CreateObject();
     cJSON_AddNumberToObject(port2, "mode", g_config.port2.mode);
     cJSON_AddNumberToObject(port2, "universe_primary", g_config.port2.universe_primary);
+    add_port_address(port2, &g_config.port2);
     cJSON_AddNumberToObject(port2, "universe_secondary", g_config.port2.universe_secondary);
     cJSON_AddNumberToObject(port2, "universe_offset", g_config.port2.universe_offset);
     cJSON_AddNumberToObject(port2, "protocol_mode", g_config.port2.protocol_mode);
     cJSON_AddNumberToObject(port2, "merge_mode", g_config.port2.merge_mode);
+    add_channel_modes(port2, &g_config.port2);
+    cJSON_AddNumberToObject(port2, "short_frame_policy", g_config.port2.short_frame_policy);
     cJSON_AddBoolToObject(port2, "rdm_enabled", g_config.port2.rdm_enabled);
     cJSON_AddItemToObject(root, "port2", port2);
     
     // Merge
     cJSON *merge = cJSON_CreateObject();
     cJSON_AddNumberToObject(merge, "timeout_seconds", g_config.merge.timeout_seconds);
+    cJSON_AddNumberToObject(merge, "source_pool_size", g_config.merge.source_pool_size);
+    cJSON_AddBoolToObject(merge, "pool_in_psram", g_config.merge.pool_in_psram);
     cJSON_AddItemToObject(root, "merge", merge);
     
     // Node info
@@ -269,17 +469,34 @@ esp_err_t config_from_json(const char *json_str)
         if ((item = cJSON_GetObjectItem(port1, "universe_primary"))) {
             g_config.port1.universe_primary = item->valueint;
         }
+        parse_port_address(port1, &g_config.port1);
         if ((item = cJSON_GetObjectItem(port1, "universe_secondary"))) {
             g_config.port1.universe_secondary = item->valueint;
         }
         if ((item = cJSON_GetObjectItem(port1, "universe_offset"))) {
-            g_config.port1.universe_offset = item->valueint;
+            if (item->valueint > -512 && item->valueint < 512) {
+                g_config.port1.universe_offset = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid universe offset %d ignored", item->valueint);
+            }
         }
         if ((item = cJSON_GetObjectItem(port1, "protocol_mode"))) {
             g_config.port1.protocol_mode = item->valueint;
         }
         if ((item = cJSON_GetObjectItem(port1, "merge_mode"))) {
-            g_config.port1.merge_mode = item->valueint;
+            if (item->valueint >= MERGE_MODE_HTP && item->valueint <= MERGE_MODE_LATEST) {
+                g_config.port1.merge_mode = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid merge mode %d ignored", item->valueint);
+            }
+        }
+        parse_channel_modes(port1, &g_config.port1);
+        if ((item = cJSON_GetObjectItem(port1, "short_frame_policy"))) {
+            if (item->valueint == SHORT_FRAME_HOLD || item->valueint == SHORT_FRAME_ZERO) {
+                g_config.port1.short_frame_policy = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid short frame policy %d ignored", item->valueint);
+            }
         }
         if ((item = cJSON_GetObjectItem(port1, "rdm_enabled"))) {
             g_config.port1.rdm_enabled = cJSON_IsTrue(item);
@@ -296,17 +513,34 @@ esp_err_t config_from_json(const char *json_str)
         if ((item = cJSON_GetObjectItem(port2, "universe_primary"))) {
             g_config.port2.universe_primary = item->valueint;
         }
+        parse_port_address(port2, &g_config.port2);
         if ((item = cJSON_GetObjectItem(port2, "universe_secondary"))) {
             g_config.port2.universe_secondary = item->valueint;
         }
         if ((item = cJSON_GetObjectItem(port2, "universe_offset"))) {
-            g_config.port2.universe_offset = item->valueint;
+            if (item->valueint > -512 && item->valueint < 512) {
+                g_config.port2.universe_offset = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid universe offset %d ignored", item->valueint);
+            }
         }
         if ((item = cJSON_GetObjectItem(port2, "protocol_mode"))) {
             g_config.port2.protocol_mode = item->valueint;
         }
         if ((item = cJSON_GetObjectItem(port2, "merge_mode"))) {
-            g_config.port2.merge_mode = item->valueint;
+            if (item->valueint >= MERGE_MODE_HTP && item->valueint <= MERGE_MODE_LATEST) {
+                g_config.port2.merge_mode = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid merge mode %d ignored", item->valueint);
+            }
+        }
+        parse_channel_modes(port2, &g_config.port2);
+        if ((item = cJSON_GetObjectItem(port2, "short_frame_policy"))) {
+            if (item->valueint == SHORT_FRAME_HOLD || item->valueint == SHORT_FRAME_ZERO) {
+                g_config.port2.short_frame_policy = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid short frame policy %d ignored", item->valueint);
+            }
         }
         if ((item = cJSON_GetObjectItem(port2, "rdm_enabled"))) {
             g_config.port2.rdm_enabled = cJSON_IsTrue(item);
@@ -320,6 +554,16 @@ esp_err_t config_from_json(const char *json_str)
         if ((item = cJSON_GetObjectItem(merge, "timeout_seconds"))) {
             g_config.merge.timeout_seconds = item->valueint;
         }
+        if ((item = cJSON_GetObjectItem(merge, "source_pool_size"))) {
+            if (item->valueint >= 1 && item->valueint <= CONFIG_MAX_SOURCE_POOL) {
+                g_config.merge.source_pool_size = item->valueint;
+            } else {
+                ESP_LOGW(TAG, "Invalid source pool size %d ignored", item->valueint);
+            }
+        }
+        if ((item = cJSON_GetObjectItem(merge, "pool_in_psram"))) {
+            g_config.merge.pool_in_psram = cJSON_IsTrue(item);
+        }
     }
     
     // Parse node_info
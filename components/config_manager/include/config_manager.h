@@ -16,13 +16,20 @@ typedef enum {
 
 // Merge modes
 typedef enum {
-    MERGE_MODE_HTP = 0,
-    MERGE_MODE_LTP,
-    MERGE_MODE_LAST,
-    MERGE_MODE_BACKUP,
-    MERGE_MODE_DISABLE
+    MERGE_MODE_HTP = 0,      // Highest value per channel
+    MERGE_MODE_LTP,          // Lowest value per channel
+    MERGE_MODE_LAST,         // Whole frame of the newest source
+    MERGE_MODE_BACKUP,       // Primary source, failover on timeout
+    MERGE_MODE_DISABLE,      // First source only
+    MERGE_MODE_LATEST        // Per channel: the source that changed it last
 } merge_mode_t;
 
+// Channels beyond a short frame (fewer than 512 slots)
+typedef enum {
+    SHORT_FRAME_HOLD = 0,    // Keep the source's previous values
+    SHORT_FRAME_ZERO         // Set to 0
+} short_frame_policy_t;
+
 // Protocol modes
 typedef enum {
     PROTOCOL_ARTNET_ONLY = 0,
@@ -43,6 +50,32 @@ typedef struct {
     char netmask[16];
 } config_wifi_profile_t;
 
+// Art-Net 15-bit Port-Address: Net (bits 14-8), Sub-Net (7-4), Universe (3-0).
+// For Art-Net a port's universe_primary/secondary hold the Port-Address.
+#define ARTNET_PORT_ADDRESS_MAX 0x7FFF
+#define ARTNET_PORT_ADDRESS(net, sub_net, universe) \
+    ((uint16_t)((((net) & 0x7F) << 8) | (((sub_net) & 0x0F) << 4) | ((universe) & 0x0F)))
+#define ARTNET_NET(address)      (((address) >> 8) & 0x7F)
+#define ARTNET_SUB_NET(address)  (((address) >> 4) & 0x0F)
+#define ARTNET_UNIVERSE(address) ((address) & 0x0F)
+
+// DMX ports (port1, port2); the router and merge engine size their tables from it
+#define CONFIG_DMX_PORT_COUNT 2
+
+// Channel merge-mode map: ranges of channels merged with their own mode,
+// every other channel uses the port's merge_mode
+#define CONFIG_MAX_CHANNEL_MODE_RANGES 32
+
+// Merge source pool size limits (merge.source_pool_size)
+#define CONFIG_DEFAULT_SOURCE_POOL 8
+#define CONFIG_MAX_SOURCE_POOL     32
+
+typedef struct {
+    uint16_t start;          // First channel (0-511)
+    uint16_t count;          // Number of channels
+    merge_mode_t mode;
+} channel_mode_range_t;
+
 // Port configuration
 typedef struct {
     dmx_mode_t mode;
@@ -51,6 +84,9 @@ typedef struct {
     int16_t universe_offset;
     protocol_mode_t protocol_mode;
     merge_mode_t merge_mode;
+    channel_mode_range_t channel_modes[CONFIG_MAX_CHANNEL_MODE_RANGES]; // Sorted, not overlapping
+    uint8_t channel_mode_count;
+    short_frame_policy_t short_frame_policy;
     bool rdm_enabled;
 } port_config_t;
 
@@ -74,6 +110,8 @@ typedef struct {
     
     struct {
         uint8_t timeout_seconds;
+        uint8_t source_pool_size;    // Sources shared by both ports, read at boot
+        bool pool_in_psram;          // Cold per-source state in PSRAM
     } merge;
     
     struct {
@@ -106,6 +144,14 @@ esp_err_t config_save(void);
  */
 config_t* config_get(void);
 
+/**
+ * @brief Get the configuration of a DMX port
+ * @param config Configuration
+ * @param port Port number (1..CONFIG_DMX_PORT_COUNT)
+ * @return Port configuration, NULL if port invalid
+ */
+const port_config_t* config_get_port(const config_t *config, uint8_t port);
+
 /**
  * @brief Reset to default configuration
  * @return ESP_OK on success
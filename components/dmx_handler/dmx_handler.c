@@ -9,6 +9,11 @@
  * - All public APIs are thread-safe using mutexes
  * - DMX output runs on dedicated tasks (Core 1)
  * - Callbacks are executed from DMX task context
+ * - With frame sync on, the output tasks meet at each frame boundary so all
+ *   ports fetch and send their frames together
+ * - Frames from a frame source are borrowed, written straight to the driver
+ *   and held until the next one arrives; the port buffer only takes a copy
+ *   when an API call edits the held frame
  * 
  * Memory Usage:
  * - ~2KB per port (context + buffers)
@@ -25,7 +30,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/event_groups.h"
 #include <string.h>
+#include <stdatomic.h>
 
 static const char *TAG = "dmx_handler";
 
@@ -48,7 +55,7 @@ static const char *TAG = "dmx_handler";
 #define DMX_TASK_CORE       1
 
 // Timing constants
-#define DMX_OUTPUT_RATE_MS  23  // ~44Hz (1000/44 ≈ 23ms)
+#define DMX_OUTPUT_RATE_MS  23  // ~44Hz (1000/44 ≈ 23ms), retry delay if the driver stalls
 #define DMX_RX_TIMEOUT_MS   1000
 #define RDM_RESPONSE_TIMEOUT_MS 200
 
@@ -90,6 +97,8 @@ typedef struct {
     
     // DMX data
     uint8_t dmx_buffer[DMX_CHANNEL_COUNT]; // DMX channel data
+    const uint8_t *held_frame;          // Borrowed frame last written, or NULL
+    bool buffer_pending;                // dmx_buffer not yet written to the driver
     SemaphoreHandle_t buffer_mutex;     // Buffer protection
     
     // Statistics
@@ -108,9 +117,12 @@ typedef struct {
     // Callbacks
     dmx_rx_callback_t rx_callback;
     void *rx_callback_user_data;
+    dmx_frame_source_t frame_source;
+    dmx_frame_release_t frame_release;
+    void *frame_source_user_data;
     rdm_discovery_callback_t discovery_callback;
     void *discovery_callback_user_data;
-    
+
 } dmx_port_context_t;
 
 /**
@@ -120,6 +132,8 @@ static struct {
     bool initialized;
     dmx_port_context_t ports[DMX_PORT_MAX];
     SemaphoreHandle_t state_mutex;
+    EventGroupHandle_t frame_sync_group; // One bit per port, frame barrier
+    atomic_bool frame_sync;             // Align output frames across ports
 } dmx_state = {
     .initialized = false,
 };
@@ -127,6 +141,7 @@ static struct {
 // Forward declarations
 static void dmx_output_task(void *arg);
 static void dmx_input_task(void *arg);
+static void frame_barrier(dmx_port_context_t *port_ctx);
 static esp_err_t port_install_driver(dmx_port_context_t *port_ctx);
 static esp_err_t port_uninstall_driver(dmx_port_context_t *port_ctx);
 
@@ -156,6 +171,31 @@ static void init_port_context(dmx_port_context_t *port_ctx, uint8_t port_num)
     port_ctx->mode = DMX_MODE_DISABLED;
 }
 
+/**
+ * @brief Give a borrowed frame back to the frame source (buffer mutex held)
+ * 
+ * @param keep Copy the frame to the port buffer first, so edits and repeats
+ *             continue from what was last sent
+ */
+static void release_held_frame(dmx_port_context_t *port_ctx, bool keep)
+{
+    if (!port_ctx->held_frame) {
+        return;
+    }
+    
+    if (keep) {
+        memcpy(port_ctx->dmx_buffer, port_ctx->held_frame, DMX_CHANNEL_COUNT);
+        port_ctx->stats.buffer_copies++;
+        port_ctx->buffer_pending = true;
+    }
+    
+    if (port_ctx->frame_release) {
+        port_ctx->frame_release(port_ctx->port_num, port_ctx->held_frame,
+                                port_ctx->frame_source_user_data);
+    }
+    port_ctx->held_frame = NULL;
+}
+
 /**
  * @brief Validate port number
  */
@@ -195,6 +235,14 @@ esp_err_t dmx_handler_init(void)
         return ESP_ERR_NO_MEM;
     }
     
+    dmx_state.frame_sync_group = xEventGroupCreate();
+    if (!dmx_state.frame_sync_group) {
+        ESP_LOGE(TAG, "Failed to create frame sync group");
+        vSemaphoreDelete(dmx_state.state_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    atomic_store(&dmx_state.frame_sync, false);
+    
     // Initialize port contexts
     for (int i = 0; i < DMX_PORT_MAX; i++) {
         init_port_context(&dmx_state.ports[i], i + 1);
@@ -231,6 +279,10 @@ esp_err_t dmx_handler_deinit(void)
     if (dmx_state.state_mutex) {
         vSemaphoreDelete(dmx_state.state_mutex);
     }
+    if (dmx_state.frame_sync_group) {
+        vEventGroupDelete(dmx_state.frame_sync_group);
+        dmx_state.frame_sync_group = NULL;
+    }
     
     dmx_state.initialized = false;
     ESP_LOGI(TAG, "DMX handler deinitialized");
@@ -251,7 +303,7 @@ esp_err_t dmx_handler_configure_port(uint8_t port, const port_config_t *config)
     
     ESP_LOGI(TAG, "Configuring port %d: mode=%d, universe=%d", 
              port, config->mode, config->universe_primary);
-    
+             
     xSemaphoreTake(dmx_state.state_mutex, portMAX_DELAY);
     
     // Stop port if running
@@ -313,6 +365,9 @@ esp_err_t dmx_handler_start_port(uint8_t port)
     char task_name[16];
     
     if (port_ctx->mode == DMX_MODE_OUTPUT || port_ctx->mode == DMX_MODE_RDM_MASTER) {
+        // A fresh driver starts blank, so the port buffer goes out first
+        port_ctx->buffer_pending = true;
+        
         snprintf(task_name, sizeof(task_name), "dmx_out_%d", port);
         BaseType_t task_ret = xTaskCreatePinnedToCore(
             dmx_output_task,
@@ -397,6 +452,10 @@ esp_err_t dmx_handler_stop_port(uint8_t port)
         port_ctx->input_task = NULL;
     }
     
+    xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, true);
+    xSemaphoreGive(port_ctx->buffer_mutex);
+    
     // Uninstall driver
     port_uninstall_driver(port_ctx);
     
@@ -424,7 +483,9 @@ esp_err_t dmx_handler_send_dmx(uint8_t port, const uint8_t *data)
     
     // Copy data to buffer
     xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, false);
     memcpy(port_ctx->dmx_buffer, data, DMX_CHANNEL_COUNT);
+    port_ctx->buffer_pending = true;
     xSemaphoreGive(port_ctx->buffer_mutex);
     
     return ESP_OK;
@@ -479,7 +540,9 @@ esp_err_t dmx_handler_set_channel(uint8_t port, uint16_t channel, uint8_t value)
     }
     
     xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, true);
     port_ctx->dmx_buffer[channel - 1] = value;
+    port_ctx->buffer_pending = true;
     xSemaphoreGive(port_ctx->buffer_mutex);
     
     return ESP_OK;
@@ -512,7 +575,9 @@ esp_err_t dmx_handler_set_channels(uint8_t port, uint16_t start_channel,
     }
     
     xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, true);
     memcpy(&port_ctx->dmx_buffer[start_channel - 1], data, length);
+    port_ctx->buffer_pending = true;
     xSemaphoreGive(port_ctx->buffer_mutex);
     
     return ESP_OK;
@@ -534,7 +599,9 @@ esp_err_t dmx_handler_blackout(uint8_t port)
     }
     
     xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, false);
     memset(port_ctx->dmx_buffer, DMX_BLACKOUT_VALUE, DMX_CHANNEL_COUNT);
+    port_ctx->buffer_pending = true;
     xSemaphoreGive(port_ctx->buffer_mutex);
     
     ESP_LOGI(TAG, "Port %d blackout", port);
@@ -607,6 +674,43 @@ esp_err_t dmx_handler_register_discovery_callback(uint8_t port,
     return ESP_OK;
 }
 
+esp_err_t dmx_handler_register_frame_source(uint8_t port, dmx_frame_source_t source,
+                                            dmx_frame_release_t release, void *user_data)
+{
+    if (!dmx_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    dmx_port_context_t *port_ctx = get_port_context(port);
+    if (!port_ctx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Taken with the buffer mutex so the output task never sees a half-updated set;
+    // the held frame goes back to the source that lent it
+    xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
+    release_held_frame(port_ctx, true);
+    port_ctx->frame_source = source;
+    port_ctx->frame_release = release;
+    port_ctx->frame_source_user_data = user_data;
+    xSemaphoreGive(port_ctx->buffer_mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t dmx_handler_set_frame_sync(bool enabled)
+{
+    if (!dmx_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (atomic_exchange(&dmx_state.frame_sync, enabled) != enabled) {
+        ESP_LOGI(TAG, "Output frame sync %s", enabled ? "enabled" : "disabled");
+    }
+    
+    return ESP_OK;
+}
+
 // RDM functions (stubs for now - full implementation requires esp-dmx library)
 esp_err_t dmx_handler_rdm_discover(uint8_t port)
 {
@@ -657,7 +761,7 @@ esp_err_t dmx_handler_get_rdm_devices(uint8_t port, rdm_device_t *devices, size_
     
     size_t copy_count = (port_ctx->rdm_device_count < *count) ? 
                         port_ctx->rdm_device_count : *count;
-    
+                        
     if (copy_count > 0) {
         memcpy(devices, port_ctx->rdm_devices, copy_count * sizeof(rdm_device_t));
     }
@@ -767,37 +871,106 @@ static esp_err_t port_uninstall_driver(dmx_port_context_t *port_ctx)
 
 /**
  * @brief DMX output task
+ * 
+ * Frame pacing comes from the wire itself: the task blocks in dmx_wait_sent()
+ * until the previous frame is out (~23ms for 512 slots), then immediately
+ * fetches the next frame. There is no separate sleep, so a frame source never
+ * drifts against the transmitter and new data waits at most one frame.
+ * 
+ * The driver keeps sending its buffer, so only a changed frame is written:
+ * a borrowed frame goes straight from the source into the driver, and a
+ * frame identical to the held one is not written again.
  */
 static void dmx_output_task(void *arg)
 {
     dmx_port_context_t *port_ctx = (dmx_port_context_t *)arg;
-    uint8_t dmx_data[DMX_CHANNEL_COUNT];
     
     ESP_LOGI(TAG, "DMX output task started for port %d", port_ctx->port_num);
     
     while (port_ctx->is_active) {
-        // Copy DMX data from buffer
+        // Frame boundary: wait until the previous frame has been transmitted
+        if (!dmx_wait_sent(port_ctx->dmx_num, DMX_TIMEOUT_TICK)) {
+            port_ctx->stats.error_count++;
+            vTaskDelay(pdMS_TO_TICKS(DMX_OUTPUT_RATE_MS));
+            continue;
+        }
+        
+        // Start this frame together with the other ports
+        if (atomic_load(&dmx_state.frame_sync)) {
+            frame_barrier(port_ctx);
+        }
+        
+        // Pull the freshest frame from the source, or repeat the last one
         xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
-        memcpy(dmx_data, port_ctx->dmx_buffer, DMX_CHANNEL_COUNT);
+        const uint8_t *frame = NULL;
+        if (port_ctx->frame_source &&
+            port_ctx->frame_source(port_ctx->port_num, &frame,
+                                   port_ctx->frame_source_user_data) == ESP_OK && frame) {
+            if (frame == port_ctx->held_frame) {
+                // Held frames never change, and the driver already has this one
+                if (port_ctx->frame_release) {
+                    port_ctx->frame_release(port_ctx->port_num, frame,
+                                            port_ctx->frame_source_user_data);
+                }
+                frame = NULL;
+            } else {
+                release_held_frame(port_ctx, false);
+                port_ctx->held_frame = frame;
+                port_ctx->buffer_pending = false;
+            }
+        } else if (port_ctx->buffer_pending) {
+            frame = port_ctx->dmx_buffer;
+            port_ctx->buffer_pending = false;
+        }
+        
+        if (frame) {
+            dmx_write(port_ctx->dmx_num, frame, DMX_CHANNEL_COUNT);
+            port_ctx->stats.driver_writes++;
+        }
         xSemaphoreGive(port_ctx->buffer_mutex);
         
         // Send DMX frame
-        dmx_wait_sent(port_ctx->dmx_num, DMX_TIMEOUT_TICK);
-        dmx_write(port_ctx->dmx_num, dmx_data, DMX_CHANNEL_COUNT);
         dmx_send(port_ctx->dmx_num);
         
         // Update statistics
         port_ctx->stats.frames_sent++;
         port_ctx->stats.last_frame_time_ms = esp_timer_get_time() / 1000;
-        
-        // Wait for next frame (~44Hz)
-        vTaskDelay(pdMS_TO_TICKS(DMX_OUTPUT_RATE_MS));
     }
     
     ESP_LOGI(TAG, "DMX output task stopped for port %d", port_ctx->port_num);
     vTaskDelete(NULL);
 }
 
+/**
+ * @brief Frame barrier between the output tasks
+ * 
+ * Waits until every other running output task reaches its frame boundary.
+ * Gives up after one frame period so a stalled port cannot hold the others.
+ */
+static void frame_barrier(dmx_port_context_t *port_ctx)
+{
+    EventBits_t own = 1 << (port_ctx->port_num - 1);
+    EventBits_t all = 0;
+    
+    for (int i = 0; i < DMX_PORT_MAX; i++) {
+        if (dmx_state.ports[i].is_active && dmx_state.ports[i].output_task) {
+            all |= 1 << i;
+        }
+    }
+    
+    if ((all & ~own) == 0) {
+        return;  // No other port to wait for
+    }
+    
+    EventBits_t bits = xEventGroupSync(dmx_state.frame_sync_group, own, all,
+                                       pdMS_TO_TICKS(DMX_OUTPUT_RATE_MS));
+    if ((bits & all) != all) {
+        // Withdraw so the other port does not pass on a stale arrival
+        xEventGroupClearBits(dmx_state.frame_sync_group, own);
+        port_ctx->stats.frame_sync_timeouts++;
+    }
+}
+
 /**
  * @brief DMX input task
  */
@@ -811,17 +984,17 @@ static void dmx_input_task(void *arg)
     while (port_ctx->is_active) {
         // Wait for DMX packet
         size_t size = dmx_receive(port_ctx->dmx_num, &packet, pdMS_TO_TICKS(DMX_RX_TIMEOUT_MS));
-
+        
         if (size > 0 && packet.sc == DMX_SC && !packet.is_rdm) {
             // Read received DMX data into buffer
             xSemaphoreTake(port_ctx->buffer_mutex, portMAX_DELAY);
             dmx_read(port_ctx->dmx_num, port_ctx->dmx_buffer, DMX_CHANNEL_COUNT);
             xSemaphoreGive(port_ctx->buffer_mutex);
-
+            
             // Update statistics
             port_ctx->stats.frames_received++;
             port_ctx->stats.last_frame_time_ms = esp_timer_get_time() / 1000;
-
+            
             // Call callback if registered
             if (port_ctx->rx_callback) {
                 port_ctx->rx_callback(port_ctx->port_num, port_ctx->dmx_buffer,
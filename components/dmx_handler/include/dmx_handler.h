@@ -70,6 +70,9 @@ typedef struct {
     uint32_t rdm_requests_sent; /**< Total RDM requests sent */
     uint32_t rdm_responses_rx;  /**< Total RDM responses received */
     uint32_t error_count;       /**< Total errors */
+    uint32_t frame_sync_timeouts; /**< Frames sent without meeting the other port */
+    uint32_t driver_writes;     /**< Frames copied into the driver (changed frames only) */
+    uint32_t buffer_copies;     /**< Borrowed frames copied into the port buffer */
     uint32_t last_frame_time_ms; /**< Last frame timestamp (ms) */
 } dmx_port_stats_t;
 
@@ -101,6 +104,35 @@ typedef void (*dmx_rx_callback_t)(uint8_t port, const uint8_t *data, size_t size
  */
 typedef void (*rdm_discovery_callback_t)(uint8_t port, uint8_t device_count, void *user_data);
 
+/**
+ * @brief DMX output frame source callback
+ * 
+ * Called by the port output task at every DMX frame boundary, right after the
+ * previous frame has left the UART, to fetch the frame to transmit next.
+ * The frame is borrowed, not copied: it must stay unchanged until the port
+ * gives it back through the release callback. Returning the frame the port
+ * already holds means "no change" and skips the driver write.
+ * 
+ * @param port Port number (1 or 2)
+ * @param frame Set to the 512-channel frame to send
+ * @param user_data User data pointer
+ * @return ESP_OK if frame is set (and borrowed), any other value to repeat
+ *         the last frame
+ */
+typedef esp_err_t (*dmx_frame_source_t)(uint8_t port, const uint8_t **frame, void *user_data);
+
+/**
+ * @brief DMX output frame release callback
+ * 
+ * Gives back a frame borrowed from the frame source. Called from the output
+ * task or from the API call that replaced the frame.
+ * 
+ * @param port Port number (1 or 2)
+ * @param frame Frame returned by the frame source
+ * @param user_data User data pointer
+ */
+typedef void (*dmx_frame_release_t)(uint8_t port, const uint8_t *frame, void *user_data);
+
 /**
  * @brief Initialize DMX handler module
  * 
@@ -365,6 +397,45 @@ esp_err_t dmx_handler_register_discovery_callback(uint8_t port,
                                                   rdm_discovery_callback_t callback,
                                                   void *user_data);
 
+/**
+ * @brief Register DMX output frame source
+ * 
+ * Registers a callback that supplies output frames. The output task calls it
+ * once per frame, timed by transmit completion, so data pushed just before a
+ * frame boundary goes out on the very next frame.
+ * Only applicable for ports in DMX_MODE_OUTPUT or DMX_MODE_RDM_MASTER mode.
+ * 
+ * Port buffer writes (send_dmx, set_channel, blackout) replace the borrowed
+ * frame until the source supplies a new one.
+ * 
+ * @param port Port number (1 or 2)
+ * @param source Frame source callback (NULL to send the port buffer only)
+ * @param release Release callback for borrowed frames (may be NULL)
+ * @param user_data User data pointer passed to both callbacks
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if port invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t dmx_handler_register_frame_source(uint8_t port, dmx_frame_source_t source,
+                                            dmx_frame_release_t release, void *user_data);
+
+/**
+ * @brief Align output frames across ports
+ * 
+ * When enabled, each output port waits at its frame boundary for the other
+ * running output port, so both fetch their frame from the frame source and
+ * start sending it together. Used while ArtSync or E1.31 sync latches the
+ * outputs, where both universes must change in the same DMX frame; free
+ * running ports do not pace each other. Cheap to call on every frame.
+ * 
+ * @param enabled true to align frames, false for free-running ports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t dmx_handler_set_frame_sync(bool enabled);
+
 #ifdef __cplusplus
 }
 #endif
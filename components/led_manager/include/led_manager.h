@@ -26,6 +26,7 @@ typedef enum {
     LED_STATE_WIFI_STA_OK,          // Green (Slow Blink)
     LED_STATE_WIFI_AP,              // Purple (Static)
     LED_STATE_RECEIVING,            // White (Pulse)
+    LED_STATE_SOURCE_LOST,          // Orange (Pulse)
     LED_STATE_RDM_DISCOVERY,        // Yellow (Slow Blink)
     LED_STATE_ERROR,                // Red (Fast Blink)
     LED_STATE_MAX
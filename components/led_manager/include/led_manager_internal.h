@@ -17,6 +17,7 @@
 #define LED_SLOW_BLINK_PERIOD_MS    1000
 #define LED_FAST_BLINK_PERIOD_MS    200
 #define LED_PULSE_DURATION_MS       50
+#define LED_SOURCE_LOST_DURATION_MS 500
 #define LED_BREATH_PERIOD_MS        2000
 #define LED_PULSE_RATE_LIMIT_MS     100
 
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "config_manager.h"
 
@@ -17,15 +18,59 @@ extern "C" {
  * It supports Art-Net, sACN, and DMX input sources with timeout management.
  * 
  * Features:
- * - Multiple merge modes (HTP, LTP, LAST, BACKUP, DISABLE)
- * - Multi-source support (up to 4 sources per port)
- * - Timeout detection and handling
+ * - Multiple merge modes (HTP, LTP, LAST, BACKUP, DISABLE, LATEST)
+ * - LATEST: per-channel Latest Takes Precedence, each channel owned by the
+ *   source that changed it last
+ * - Channel-mode map: ranges of channels merged with their own mode (e.g.
+ *   HTP intensity, LATEST attributes)
+ * - Multi-source support: a source pool shared by all merges, sized at init
+ *   (up to 16 sources per merge)
+ * - Timeout detection against a per-merge deadline, one clock read per frame;
+ *   expiries are counted and reported through a callback
  * - Source tracking (protocol, IP, name, priority)
- * - Thread-safe operation
+ * - Lock-free pushes (triple-buffered source slots), per-merge locking
+ * - E1.31 priority arbitration: only the highest-priority sources are merged
+ * - E1.31 per-address priority (0xDD): arbitration channel by channel
+ * - Incremental merge: only channels that changed since the last merge are
+ *   recomputed
+ * - Universe merges: one merge per received universe, each run once per
+ *   frame however many ports output it
+ * - Ports subscribe to the merges of the universes they output, each at a
+ *   channel offset, and compose them on read; a port reading one merge at
+ *   offset 0 borrows its refcounted frame without a copy
+ * - ArtSync / E1.31 sync: the ports of the latched merges change together on each sync
+ * - sACN sources are identified by CID; source names are interned once and
+ *   referenced by a small handle
+ * - Zero-copy output: merged frames are lent to the outputs by reference
  */
 
-// Maximum sources per port
-#define MERGE_MAX_SOURCES 4
+// DMX output ports
+#define MERGE_MAX_PORTS CONFIG_DMX_PORT_COUNT
+
+// Merges one port reads: primary and secondary universe, each over two protocols
+#define MERGE_PORT_MERGES 4
+
+// Universe merges; ports subscribe to them
+#define MERGE_MAX_MERGES (MERGE_MAX_PORTS * MERGE_PORT_MERGES)
+
+// Maximum sources merged in one merge
+#define MERGE_MAX_SOURCES 16
+
+// Source pool shared by all merges (merge_pool_config_t)
+#define MERGE_DEFAULT_POOL_SOURCES 8
+#define MERGE_POOL_MAX_SOURCES     32
+
+// Priority given to sources without one of their own (Art-Net, DMX input)
+#define MERGE_DEFAULT_PRIORITY 100
+
+// sACN component ID (CID) size
+#define MERGE_CID_LENGTH 16
+
+// Longest source name kept (E1.31 source name field)
+#define MERGE_SOURCE_NAME_LENGTH 64
+
+// Name handle of a source without a name
+#define MERGE_NAME_NONE 0xFF
 
 // Default timeout (2.5 seconds in microseconds)
 #define MERGE_DEFAULT_TIMEOUT_US 2500000
@@ -47,12 +92,29 @@ typedef struct {
     uint64_t timestamp_us;         /**< Timestamp in microseconds */
     uint32_t sequence;             /**< Sequence number */
     uint8_t priority;              /**< Source priority (0-200, sACN only) */
-    char source_name[64];          /**< Source identifier */
+    uint8_t name_id;               /**< Interned source name (MERGE_NAME_NONE if none) */
     uint32_t source_ip;            /**< Source IP address */
     source_protocol_t protocol;    /**< Protocol type */
+    uint16_t universe;             /**< Universe the source sends */
     bool is_valid;                 /**< Data valid flag */
 } dmx_source_data_t;
 
+/**
+ * @brief One merge a port outputs
+ */
+typedef struct {
+    uint8_t merge;                 /**< Merge number (1..MERGE_MAX_MERGES) */
+    int16_t offset;                /**< Merge channel n is output on port channel n + offset (-511..511) */
+} merge_subscription_t;
+
+/**
+ * @brief Source pool configuration
+ */
+typedef struct {
+    uint8_t sources;               /**< Source slots shared by all merges (1-32) */
+    bool cold_in_psram;            /**< 0xDD maps and names in PSRAM (if available) */
+} merge_pool_config_t;
+
 /**
  * @brief Merge engine statistics
  */
@@ -61,22 +123,58 @@ typedef struct {
     uint32_t htp_merges;           /**< HTP merge count */
     uint32_t ltp_merges;           /**< LTP merge count */
     uint32_t last_merges;          /**< LAST merge count */
+    uint32_t latest_merges;        /**< LATEST (per-channel LTP) merge count */
+    uint32_t owner_rebuilds;       /**< LATEST merges that reassigned every channel */
+    uint32_t mode_map_merges;      /**< Merges run span by span over a channel-mode map */
     uint32_t backup_switches;      /**< Backup failover count */
     uint32_t source_timeouts;      /**< Source timeout count */
     uint32_t active_sources;       /**< Currently active sources */
+    uint32_t clean_frames;         /**< Outputs served without re-merge (no new data) */
+    uint32_t active_priority;      /**< Priority of the sources currently merged */
+    uint32_t channel_priority_merges; /**< Merges arbitrated per channel (0xDD) */
+    uint32_t channels_recomputed;  /**< Channels recomputed by the last merge */
+    uint32_t channels_recomputed_total; /**< Channels recomputed by all merges */
+    uint32_t sync_latches;         /**< Outputs latched by ArtSync */
+    uint32_t source_terminations;  /**< sACN sources dropped on stream termination */
+    uint32_t slot_copies;          /**< Received frames copied into a source slot */
+    uint32_t output_refs;          /**< Frames lent to an output by reference */
+    uint32_t output_copies;        /**< Frames copied out (get_output, or into a composed port frame) */
+    uint32_t output_cow_copies;    /**< Merges that moved off a frame still held */
+    uint32_t source_overflows;     /**< Pushes dropped because the source pool was full */
+    uint32_t expiry_scans;         /**< Deadlines passed, sources checked for timeout */
+    uint32_t pool_free;            /**< Unused slots in the shared source pool */
+    uint32_t subscribers;          /**< Ports outputting the merge */
 } merge_stats_t;
 
+/**
+ * @brief Source expiry callback
+ * 
+ * Called from the task fetching a subscribed port's output, with the merge
+ * locked: must not block or call back into the merge engine.
+ * 
+ * @param merge Merge whose sources expired
+ * @param expired Sources that timed out
+ * @param remaining Sources still active in the merge
+ * @param user_data User data pointer
+ */
+typedef void (*merge_expiry_callback_t)(uint8_t merge, uint8_t expired, uint8_t remaining,
+                                        void *user_data);
+
 /**
  * @brief Initialize merge engine
  * 
  * Initializes the merge engine module. Must be called before any other functions.
+ * Allocates the source pool: the slots in internal RAM, the cold per-source
+ * state in PSRAM if requested (falling back to internal RAM).
  * 
+ * @param config Source pool configuration (NULL = MERGE_DEFAULT_POOL_SOURCES, PSRAM)
  * @return
  *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if the pool size is out of range
  *     - ESP_ERR_NO_MEM if memory allocation failed
  *     - ESP_ERR_INVALID_STATE if already initialized
  */
-esp_err_t merge_engine_init(void);
+esp_err_t merge_engine_init(const merge_pool_config_t *config);
 
 /**
  * @brief Deinitialize merge engine
@@ -89,84 +187,229 @@ esp_err_t merge_engine_init(void);
 esp_err_t merge_engine_deinit(void);
 
 /**
- * @brief Configure merge engine for a port
+ * @brief Configure a merge
  * 
- * Configures merge mode and timeout for the specified port.
+ * Configures merge mode and timeout for the specified merge.
  * 
- * @param port Port number (1 or 2)
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
  * @param mode Merge mode from config_manager
  * @param timeout_ms Timeout in milliseconds (0 = use default)
  * @return
  *     - ESP_OK on success
- *     - ESP_ERR_INVALID_ARG if port invalid
+ *     - ESP_ERR_INVALID_ARG if merge or mode invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_config(uint8_t merge, merge_mode_t mode, uint32_t timeout_ms);
+
+/**
+ * @brief Set per-channel merge modes for a merge
+ * 
+ * Channels inside a range are merged with its mode, all others with the
+ * merge mode from merge_engine_config. The merge runs each mode over the
+ * contiguous channels that share it; LAST, BACKUP and DISABLE pick their
+ * source once and copy it into each of their spans. Ranges may overlap
+ * (later ones win) and are clipped to the universe. Pass count 0 to clear
+ * the map.
+ * 
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
+ * @param ranges Channel ranges (NULL if count is 0)
+ * @param count Number of ranges (up to CONFIG_MAX_CHANNEL_MODE_RANGES)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
  *     - ESP_ERR_INVALID_STATE if not initialized
  */
-esp_err_t merge_engine_config(uint8_t port, merge_mode_t mode, uint32_t timeout_ms);
+esp_err_t merge_engine_set_channel_modes(uint8_t merge, const channel_mode_range_t *ranges,
+                                         uint8_t count);
+
+/**
+ * @brief Set how a merge treats channels beyond a short frame
+ * 
+ * With SHORT_FRAME_HOLD a source keeps its previous values for the
+ * channels it did not send; with SHORT_FRAME_ZERO they are set to 0.
+ * Takes effect from the next push.
+ * 
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
+ * @param policy Short frame policy
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_set_short_frame_policy(uint8_t merge, short_frame_policy_t policy);
+
+/**
+ * @brief Register the source expiry callback
+ * 
+ * Register before data flows; a later change is not synchronized with the
+ * merge.
+ * 
+ * @param callback Callback function
+ * @param user_data User data pointer passed to callback
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if callback is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_set_expiry_callback(merge_expiry_callback_t callback, void *user_data);
+
+/**
+ * @brief Set the merges a port outputs
+ * 
+ * The port's output calls then compose these merges, each shifted by its
+ * offset; channels no merge reaches are 0. Where merges overlap, HTP keeps
+ * the highest and LTP the lowest value; the other modes take the merge that
+ * changed last (LAST, LATEST) or the first in the list (BACKUP, DISABLE).
+ * Any number of ports can subscribe to one merge; it is still merged once
+ * per frame. Replaces the port's previous subscriptions; port n starts
+ * subscribed to merge n at offset 0.
+ * 
+ * @param port Port number (1..MERGE_MAX_PORTS)
+ * @param merges Merges to output, most preferred first (NULL if count is 0)
+ * @param count Number of merges (0..MERGE_PORT_MERGES, 0 = output nothing)
+ * @param mode How overlapping merges combine (normally the port's merge mode)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_subscribe(uint8_t port, const merge_subscription_t *merges,
+                                 uint8_t count, merge_mode_t mode);
+
+/**
+ * @brief Get the merges a port outputs
+ * 
+ * @param port Port number (1..MERGE_MAX_PORTS)
+ * @param merges Output array (MERGE_PORT_MERGES is enough)
+ * @param max_merges Size of output array
+ * @return Number of merges written, 0 if port invalid or not initialized
+ */
+uint8_t merge_engine_get_port_merges(uint8_t port, merge_subscription_t *merges,
+                                     uint8_t max_merges);
 
 /**
  * @brief Push Art-Net data to merge engine
  * 
- * Adds or updates Art-Net source data for merging.
+ * Adds or updates Art-Net source data for merging. Art-Net sources carry
+ * MERGE_DEFAULT_PRIORITY.
+ * Does not block once the source has a slot; each source must be pushed from
+ * a single task.
  * 
- * @param port Port number (1 or 2)
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
  * @param universe Universe number
- * @param data DMX data (512 channels)
+ * @param data DMX data
+ * @param length Number of channels in data (1-512). Channels beyond it
+ *               follow the merge's short frame policy.
  * @param sequence Sequence number
  * @param source_ip Source IP address
  * @return
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if parameters invalid
  *     - ESP_ERR_INVALID_STATE if not initialized
- *     - ESP_ERR_NO_MEM if maximum sources reached
+ *     - ESP_ERR_NO_MEM if the source pool is full
  */
-esp_err_t merge_engine_push_artnet(uint8_t port, uint16_t universe,
-                                   const uint8_t *data, uint8_t sequence,
-                                   uint32_t source_ip);
+esp_err_t merge_engine_push_artnet(uint8_t merge, uint16_t universe,
+                                   const uint8_t *data, uint16_t length,
+                                   uint8_t sequence, uint32_t source_ip);
 
 /**
  * @brief Push sACN data to merge engine
  * 
- * Adds or updates sACN source data for merging.
+ * Adds or updates sACN source data for merging. Only the sources at the
+ * highest active priority in a merge are merged; lower-priority sources are
+ * kept tracked and take over when the higher ones time out.
  * 
- * @param port Port number (1 or 2)
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
  * @param universe Universe number
  * @param data DMX data (512 channels)
  * @param sequence Sequence number
  * @param priority Priority (0-200)
- * @param source_name Source name
+ * @param source_name Source name (up to MERGE_SOURCE_NAME_LENGTH bytes, need not
+ *                    be NUL-terminated; NULL if unknown)
+ * @param cid Source component ID (MERGE_CID_LENGTH bytes, NULL if unknown)
  * @param source_ip Source IP address
  * @return
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if parameters invalid
  *     - ESP_ERR_INVALID_STATE if not initialized
- *     - ESP_ERR_NO_MEM if maximum sources reached
+ *     - ESP_ERR_NO_MEM if the source pool is full
  */
-esp_err_t merge_engine_push_sacn(uint8_t port, uint16_t universe,
+esp_err_t merge_engine_push_sacn(uint8_t merge, uint16_t universe,
                                  const uint8_t *data, uint8_t sequence,
                                  uint8_t priority, const char *source_name,
-                                 uint32_t source_ip);
+                                 const uint8_t *cid, uint32_t source_ip);
+
+/**
+ * @brief Push sACN per-address priority (start code 0xDD) to merge engine
+ * 
+ * Stores the source's per-channel priority map. While a source has a map,
+ * the merge is arbitrated channel by channel: each channel is merged only
+ * from the sources with the highest priority for it, and a map entry of 0
+ * means the source does not drive that channel. Sources without a map use
+ * their packet priority on every channel. A map expires with the source
+ * timeout if no new 0xDD frame arrives.
+ * 
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
+ * @param universe Universe number
+ * @param priorities Per-channel priorities (512 entries, 0-200)
+ * @param source_name Source name (up to MERGE_SOURCE_NAME_LENGTH bytes, need not
+ *                    be NUL-terminated; NULL if unknown)
+ * @param cid Source component ID (MERGE_CID_LENGTH bytes, NULL if unknown)
+ * @param source_ip Source IP address
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NO_MEM if the source pool is full
+ */
+esp_err_t merge_engine_push_sacn_priority(uint8_t merge, uint16_t universe,
+                                          const uint8_t *priorities,
+                                          const char *source_name,
+                                          const uint8_t *cid, uint32_t source_ip);
+
+/**
+ * @brief Drop an sACN source that terminated its stream
+ * 
+ * Called when a source sends the Stream_Terminated option: the source leaves
+ * the merge at once instead of after the source timeout, so BACKUP and
+ * priority failover happen on the next frame. A later packet from the same
+ * source brings it back.
+ * 
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
+ * @param universe Universe number
+ * @param cid Source component ID (MERGE_CID_LENGTH bytes)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NOT_FOUND if the source is not tracked in this merge
+ */
+esp_err_t merge_engine_terminate_sacn(uint8_t merge, uint16_t universe, const uint8_t *cid);
 
 /**
  * @brief Push DMX input data to merge engine
  * 
- * Adds or updates DMX input source data for merging.
+ * Adds or updates DMX input source data in the first merge the port
+ * outputs (its primary universe).
  * 
- * @param port Port number (1 or 2)
+ * @param port Port number (1..MERGE_MAX_PORTS)
  * @param data DMX data (512 channels)
  * @return
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if parameters invalid
- *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_INVALID_STATE if not initialized or the port outputs no merge
  */
 esp_err_t merge_engine_push_dmx_in(uint8_t port, const uint8_t *data);
 
 /**
  * @brief Get merged output data
  * 
- * Retrieves the merged DMX data for the specified port.
- * Performs merge operation if needed.
+ * Retrieves the port's frame, composed from the merges it subscribes to.
+ * A merge only runs if a source was pushed or timed out since the previous
+ * call, so calling this once per DMX frame boundary is cheap.
+ * In ArtSync mode each merge gives the frame latched by the last sync instead.
  * 
- * @param port Port number (1 or 2)
+ * @param port Port number (1..MERGE_MAX_PORTS)
  * @param data Buffer to store merged data (512 channels)
  * @return
  *     - ESP_OK on success
@@ -176,12 +419,75 @@ esp_err_t merge_engine_push_dmx_in(uint8_t port, const uint8_t *data);
  */
 esp_err_t merge_engine_get_output(uint8_t port, uint8_t *data);
 
+/**
+ * @brief Borrow the merged output frame without copying it
+ * 
+ * Same as merge_engine_get_output, but returns a reference to the frame
+ * itself: the merged frame of a port reading one merge at offset 0, else
+ * a frame of the port's own composed from its merges. The frame stays
+ * unchanged until it is released; merges in the meantime go to another
+ * buffer. Every successful call must be paired with
+ * merge_engine_release_output.
+ * 
+ * @param port Port number (1..MERGE_MAX_PORTS)
+ * @param data Set to the 512-channel frame, or NULL if none is returned
+ * @return
+ *     - ESP_OK on success (a reference is held)
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_TIMEOUT if no active sources (no reference is held)
+ */
+esp_err_t merge_engine_acquire_output(uint8_t port, const uint8_t **data);
+
+/**
+ * @brief Release a frame borrowed with merge_engine_acquire_output
+ * 
+ * Lock-free; may be called from any task.
+ * 
+ * @param data Frame returned by merge_engine_acquire_output
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if data is not a borrowed frame
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_release_output(const uint8_t *data);
+
+/**
+ * @brief Latch merges on a sync (ArtSync or E1.31 sync packet)
+ * 
+ * Merges each listed merge that has subscribers from the data pushed so far
+ * and holds the result as its ports' output until its next latch. The first
+ * latch puts a merge in sync mode; without another for timeout_ms it returns
+ * to immediate mode, where get_output merges on every frame. Merges not
+ * listed keep their own mode.
+ * 
+ * @param merges Merges to latch (1..MERGE_MAX_MERGES)
+ * @param count Number of merges
+ * @param timeout_ms Sync timeout of the protocol (4000 for ArtSync, 2500 for E1.31)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if merges is NULL or empty, holds an invalid
+ *       merge, or timeout_ms is 0
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t merge_engine_sync_latch(const uint8_t *merges, uint8_t count, uint32_t timeout_ms);
+
+/**
+ * @brief Check if any output is held to sync latches
+ * 
+ * Lock-free; cheap enough to call on every DMX frame.
+ * 
+ * @return true while a merge is in sync mode, false otherwise
+ */
+bool merge_engine_is_sync_active(void);
+
 /**
  * @brief Check if output is active
  * 
- * Checks if there are any active sources within the timeout period.
+ * Checks if any merge the port outputs has active sources within the
+ * timeout period.
  * 
- * @param port Port number (1 or 2)
+ * @param port Port number (1..MERGE_MAX_PORTS)
  * @return true if output active, false otherwise
  */
 bool merge_engine_is_output_active(uint8_t port);
@@ -189,9 +495,10 @@ bool merge_engine_is_output_active(uint8_t port);
 /**
  * @brief Force blackout
  * 
- * Clears all sources and outputs zero for all channels.
+ * Clears all sources of the merges the port outputs and outputs zero for
+ * all their channels, on every port subscribed to them.
  * 
- * @param port Port number (1 or 2)
+ * @param port Port number (1..MERGE_MAX_PORTS)
  * @return
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if port invalid
@@ -202,9 +509,10 @@ esp_err_t merge_engine_blackout(uint8_t port);
 /**
  * @brief Get active sources
  * 
- * Retrieves information about currently active sources.
+ * Retrieves information about the currently active sources of the merges
+ * the port outputs.
  * 
- * @param port Port number (1 or 2)
+ * @param port Port number (1..MERGE_MAX_PORTS)
  * @param sources Buffer to store source information
  * @param max_sources Maximum number of sources to return
  * @return Number of active sources
@@ -213,32 +521,49 @@ uint8_t merge_engine_get_active_sources(uint8_t port,
                                        dmx_source_data_t *sources,
                                        uint8_t max_sources);
 
+/**
+ * @brief Get a source name by handle
+ * 
+ * Resolves the name_id of a dmx_source_data_t. The name is truncated to
+ * fit and always NUL-terminated.
+ * 
+ * @param name_id Name handle
+ * @param name Buffer to store the name
+ * @param max_length Size of the buffer
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NOT_FOUND if the handle is not in use
+ */
+esp_err_t merge_engine_get_source_name(uint8_t name_id, char *name, size_t max_length);
+
 /**
  * @brief Get merge statistics
  * 
- * Retrieves merge engine statistics for the specified port.
+ * Retrieves the statistics of one universe merge.
  * 
- * @param port Port number (1 or 2)
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
  * @param stats Pointer to statistics structure
  * @return
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if parameters invalid
  *     - ESP_ERR_INVALID_STATE if not initialized
  */
-esp_err_t merge_engine_get_stats(uint8_t port, merge_stats_t *stats);
+esp_err_t merge_engine_get_stats(uint8_t merge, merge_stats_t *stats);
 
 /**
  * @brief Reset statistics
  * 
- * Resets merge statistics for the specified port.
+ * Resets the statistics of one universe merge.
  * 
- * @param port Port number (1 or 2)
+ * @param merge Merge number (1..MERGE_MAX_MERGES)
  * @return
  *     - ESP_OK on success
- *     - ESP_ERR_INVALID_ARG if port invalid
+ *     - ESP_ERR_INVALID_ARG if merge invalid
  *     - ESP_ERR_INVALID_STATE if not initialized
  */
-esp_err_t merge_engine_reset_stats(uint8_t port);
+esp_err_t merge_engine_reset_stats(uint8_t merge);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,40 @@
+/**
+ * @file merge_kernel.h
+ * @brief Internal HTP/LTP channel kernels for the merge engine
+ * 
+ * One interface, implementation chosen at build time:
+ * - SSE2 or NEON 128-bit max/min when the compiler targets them (host builds)
+ * - 32-bit SWAR otherwise (ESP32-S3), four channels per word without branches,
+ *   or on any build with MERGE_KERNEL_FORCE_SWAR defined
+ */
+
+#ifndef MERGE_KERNEL_H
+#define MERGE_KERNEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief dst[i] = max(dst[i], src[i]) for i in [0, len)
+ */
+void merge_kernel_max(uint8_t *dst, const uint8_t *src, size_t len);
+
+/**
+ * @brief dst[i] = min(dst[i], src[i]) for i in [0, len)
+ */
+void merge_kernel_min(uint8_t *dst, const uint8_t *src, size_t len);
+
+/**
+ * @brief Name of the kernel selected at build time (for logging)
+ */
+const char* merge_kernel_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MERGE_KERNEL_H
@@ -3,75 +3,381 @@
  * @brief Merge Engine Implementation
  * 
  * This component merges DMX data from multiple sources using various algorithms.
- * It supports HTP, LTP, LAST, BACKUP, and DISABLE modes with timeout management.
+ * It supports HTP, LTP, LAST, BACKUP, DISABLE and LATEST modes with timeout
+ * management.
  * 
  * Thread Safety:
- * - All public APIs are thread-safe using mutexes
- * - Merge operations are atomic per port
+ * - Pushes are lock-free: each source slot is a triple buffer with exactly one
+ *   writer (the task that receives that source) and one reader (the merger)
+ * - Each merge has its own mutex, taken only to claim a slot and to merge, so
+ *   traffic on one merge never waits on another
+ * 
+ * Source pool:
+ * - Source slots come from one pool shared by all merges, sized at init.
+ *   A merge binds a slot when a new source arrives and gives it back once
+ *   the source has been silent for the timeout, so a busy universe can use
+ *   slots the other merges do not need
+ * - The slots (frames, stamps) stay in internal RAM; the rarely used 0xDD
+ *   maps and the name table can go to PSRAM
+ * - A source that finds the pool full is counted, and logged at most once
+ *   per MERGE_OVERFLOW_LOG_INTERVAL_MS
+ * 
+ * Priority:
+ * - Only sources at the highest active priority take part in a merge (E1.31
+ *   per-source priority); ties are merged with the configured mode
+ * - The top-priority set is updated when a source arrives, changes priority
+ *   or times out, not rescanned on every frame
+ * - Sources that send E1.31 per-address priority (start code 0xDD) are
+ *   arbitrated channel by channel. The per-channel winners are kept as one
+ *   bitmap per source and rebuilt only when a 0xDD frame arrives or the
+ *   source set changes
+ * 
+ * Timeouts:
+ * - Each output frame reads the clock once; that snapshot is used for every
+ *   source and 0xDD map check of the frame
+ * - Writers flag their slot in a fresh mask, so the merger only looks at
+ *   slots with new frames
+ * - Each merge keeps the earliest time one of its sources or maps can expire.
+ *   Until then nothing is scanned; past it the sources are checked and the
+ *   deadline recomputed. Expiries are counted and reported to the expiry
+ *   callback
+ * 
+ * Incremental merge:
+ * - Each push records the channel span that differs from the source's
+ *   previous frame; the merger only recomputes the union of those spans
+ * - Source arrivals, timeouts and priority or mode changes recompute all
+ *   512 channels
+ * - Short frames (e.g. ArtDmx with fewer than 512 slots) only copy and diff
+ *   the received channels; the rest hold or zero per the port's policy
+ * 
+ * Per-channel Latest Takes Precedence (MERGE_MODE_LATEST):
+ * - In LATEST mode each push also records which channels differ from the
+ *   source's previous frame, as a bitmap
+ * - The merger stamps those channels with a tick and hands them to
+ *   their source, so a merge only touches the channels that changed
+ * - When the source set changes every channel goes back to the source
+ *   whose stamp on it is newest
+ * 
+ * Channel-mode map:
+ * - A merge can merge ranges of channels with their own mode. The map is
+ *   kept as spans of one mode covering all 512 channels, and the merge runs
+ *   each span's kernel over the dirty channels inside it
+ * - Without a map the merge is a single span and merges exactly as before
+ * 
+ * Universe merges:
+ * - A merge takes the sources of one received universe (one protocol's
+ *   universe number). Pushes, settings and expiry address merges, not ports
+ * - A universe is pushed once and merged once per frame however many ports
+ *   output it
+ * - The merge keeps a count of its subscribers; one without any is not
+ *   latched on sync
+ * 
+ * Ports:
+ * - A port subscribes to the merges of the universes it outputs (primary and
+ *   secondary, each protocol it takes), each at a channel offset applied
+ *   when the port reads it
+ * - A port reading one merge at offset 0 borrows the merged frame by
+ *   reference. Otherwise the merged frames are composed into a frame of the
+ *   port's own, combined with the port's mode where they overlap
+ * 
+ * Source identity:
+ * - sACN sources are keyed by CID, so consoles behind one NAT stay apart and
+ *   one console on two interfaces stays one source; other protocols by IP
+ * - Source names are interned once per source in a table shared by all
+ *   merges; slots hold a one-byte handle and pushes never copy the name
+ * 
+ * Synchronization (ArtSync, E1.31 sync packets):
+ * - A sync latches the merges it names. Once latched, a merge's pushes are
+ *   only staged in the source slots and its ports read the frame merged at
+ *   the last latch, so they all change on the same sync. Without a sync for
+ *   the timeout given by its last latch the merge falls back to merging on
+ *   every output frame; other merges are not affected
+ * 
+ * Zero-copy output:
+ * - A received payload is copied once, into its source slot; the
+ *   short-frame and dirty-span handling need it there
+ * - Merged frames are refcounted buffers handed to the DMX outputs and the
+ *   sync latch by reference. A merge never writes a held frame: it carries
+ *   the unchanged channels over to a free buffer and merges there
  * 
  * Memory Usage:
- * - ~4KB per port (context + sources)
- * - Total: ~8KB for 2 ports
+ * - ~3KB internal RAM per pooled source slot (3 frames + LATEST change
+ *   stamps), ~0.6KB per slot for its 0xDD map and name (PSRAM if enabled)
+ * - ~6KB per merge (6 output buffers + per-channel state), MERGE_MAX_MERGES
+ *   merges whether routed or not, plus 1KB of composed frames per port
+ * - Total with the default pool of 8 sources: ~75KB internal, ~5KB PSRAM
  */
 
 #include "merge_engine.h"
+#include "merge_kernel.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include <string.h>
 #include <inttypes.h>
-#include <inttypes.h>
+#include <stdatomic.h>
 
 static const char *TAG = "merge_engine";
 
+// Triple buffer index encoding: low bits = frame index, FRESH = not yet consumed
+#define SLOT_INDEX_MASK 0x03
+#define SLOT_FRESH      0x04
+#define SLOT_NONE       0x03       // No frame published yet
+
+// Per-channel bitmap size in 32-bit words
+#define CHANNEL_MAP_WORDS (512 / 32)
+
+// Least time between two "source pool full" warnings of a merge
+#define MERGE_OVERFLOW_LOG_INTERVAL_MS 10000
+
+// Output buffers per merge: every port borrowing the merge's frames holds its
+// last frame and, while fetching, the next; the sync latch holds one more and
+// the merge needs one free to write into
+#define MERGE_OUTPUT_BUFFERS (2 * MERGE_MAX_PORTS + 2)
+#define MERGE_OUTPUT_NONE    -1
+
+// Composed frames per port: its last frame and, while fetching, the next
+#define MERGE_PORT_FRAMES 2
+
+// sync_mask has one bit per merge
+#if MERGE_MAX_MERGES > 32
+#error "MERGE_MAX_MERGES exceeds the sync mask"
+#endif
+
+// LATEST change stamps are 16-bit ticks. Stamps older than this are
+// pulled up to it every LATEST_AGE_LIMIT ticks, so ages never wrap
+#define LATEST_AGE_LIMIT 0x4000
+
+// No source owns the channel (LATEST)
+#define LATEST_OWNER_NONE -1
+
+// A map of N ranges splits the port into at most 2N + 1 spans
+#define MERGE_MAX_SPANS (2 * CONFIG_MAX_CHANNEL_MODE_RANGES + 1)
+
+/**
+ * @brief Source identity: one sender's stream of a universe
+ */
+typedef struct {
+    uint32_t source_ip;            /**< Art-Net / DMX input sender, 0 for sACN */
+    source_protocol_t protocol;
+    uint16_t universe;
+    uint8_t cid[MERGE_CID_LENGTH]; /**< sACN component ID, zero otherwise */
+} source_key_t;
+
+/**
+ * @brief One frame of source data, published as a unit
+ */
+typedef struct {
+    uint8_t data[512];             /**< DMX data */
+    uint64_t timestamp_us;         /**< Receive time */
+    uint32_t sequence;             /**< Sequence number */
+    uint8_t priority;              /**< Source priority */
+    uint16_t dirty_lo;             /**< Channels changed since the merger's last */
+    uint16_t dirty_hi;             /**< frame of this source: [dirty_lo, dirty_hi) */
+    bool has_changes;              /**< changed is set (LATEST); else use the span */
+    uint32_t changed[CHANNEL_MAP_WORDS]; /**< Channels changed, same frames as the span */
+} merge_frame_t;
+
+/**
+ * @brief Rarely used slot state, kept apart from the frames (PSRAM if enabled)
+ */
+typedef struct {
+    uint8_t channel_priority[512]; /**< Last 0xDD map (0 = channel not driven) */
+    uint64_t channel_priority_time_us; /**< Receive time of the map */
+} merge_slot_cold_t;
+
+/**
+ * @brief Source slot
+ * 
+ * frames[back] belongs to the writer, frames[front] to the merger, and the
+ * middle index is exchanged atomically between them. The writer never blocks
+ * and the merger always sees a complete frame.
+ */
+typedef struct {
+    merge_frame_t frames[3];
+    uint32_t back;                 /**< Writer-owned frame index */
+    uint32_t published;            /**< Last published index (writer side) */
+    uint16_t extent;               /**< End of the longest frame; beyond it all frames are 0 */
+    uint32_t front;                /**< Merger-owned frame index */
+    atomic_uint middle;            /**< Latest published index | SLOT_FRESH */
+    
+    // Identity, written under the merge mutex before in_use is published
+    atomic_bool in_use;
+    source_key_t key;
+    uint32_t source_ip;            /**< Address the source was first seen from */
+    uint8_t name_id;               /**< Interned name, MERGE_NAME_NONE if unset */
+    uint8_t index;                 /**< Index in the owning merge's sources */
+    
+    // Merger-side state
+    bool is_valid;                 /**< frames[front] holds live data */
+    bool terminated;               /**< Stream terminated, slot may be recycled */
+    uint8_t priority;              /**< Priority of frames[front] */
+    
+    // Per-address priority (0xDD), written under the merge mutex
+    merge_slot_cold_t *cold;
+    
+    // LATEST, merger side
+    uint32_t pending_changes[CHANNEL_MAP_WORDS]; /**< Changed channels not yet merged */
+    uint16_t change_tick[512];     /**< Tick of the last change per channel */
+} merge_slot_t;
+
+/**
+ * @brief Channels merged with one mode: [lo, hi)
+ */
+typedef struct {
+    uint16_t lo;
+    uint16_t hi;
+    merge_mode_t mode;
+} merge_span_t;
+
+/**
+ * @brief Merged frame, lent to the outputs by reference
+ * 
+ * A buffer is only written while nobody holds it; a merge over a held frame
+ * moves to a free buffer first (copy on write).
+ */
+typedef struct {
+    uint8_t data[512] __attribute__((aligned(4))); /**< Word aligned for the kernels */
+    atomic_uint refs;              /**< Outputs and latch holding the frame */
+} output_buffer_t;
+
 /**
- * @brief Merge context for one port
+ * @brief Merge context for one universe merge
  */
 typedef struct {
-    uint8_t port_num;              /**< Port number (1 or 2) */
-    uint16_t universe;             /**< Target universe */
+    uint8_t merge_num;             /**< Merge number (1..MERGE_MAX_MERGES) */
+    atomic_uint subscribers;       /**< Ports outputting this merge */
     merge_mode_t mode;             /**< Merge mode */
+    short_frame_policy_t short_frame_policy; /**< Channels beyond a short frame */
     uint32_t timeout_us;           /**< Timeout in microseconds */
-    
-    // Source tracking
-    dmx_source_data_t sources[MERGE_MAX_SOURCES];
-    uint8_t source_count;
-    
-    // Output buffer
-    uint8_t merged_data[512];
-    uint64_t last_merge_time_us;
+    SemaphoreHandle_t mutex;       /**< Guards slot claims and merging */
+    
+    // Channel-mode map, as spans covering all 512 channels in order
+    channel_mode_range_t mode_ranges[CONFIG_MAX_CHANNEL_MODE_RANGES];
+    uint8_t mode_range_count;
+    merge_span_t spans[MERGE_MAX_SPANS];
+    uint8_t span_count;
+    const merge_span_t *span;      /**< Span being merged */
+    bool latest_in_use;            /**< A span uses MERGE_MODE_LATEST */
+    
+    // Source tracking: slots bound from the pool, NULL if unused
+    merge_slot_t *_Atomic sources[MERGE_MAX_SOURCES];
+    atomic_uint fresh_mask;        /**< Slots with a published frame not yet taken */
+    uint64_t next_expiry_us;       /**< No source or 0xDD map expires before this */
+    atomic_uint source_overflows;  /**< Pushes refused, pool full (lock-free) */
+    atomic_uint overflow_log_ms;   /**< Time of the last pool full warning */
+    
+    // Priority arbitration
+    uint32_t priority_mask;        /**< Valid sources at top_priority (bit per slot) */
+    uint8_t top_priority;          /**< Highest priority among valid sources */
+    
+    // Per-channel arbitration (only used while a source has a 0xDD map)
+    uint32_t channel_map_mask;     /**< Slots holding a live 0xDD map */
+    uint32_t channel_winners[MERGE_MAX_SOURCES][CHANNEL_MAP_WORDS]; /**< Per slot: channels it wins */
+    bool channel_winners_stale;    /**< Rebuild winners before the next merge */
+    
+    // Output buffers; the merge kernels write merged_data
+    output_buffer_t outputs[MERGE_OUTPUT_BUFFERS];
+    int8_t current_output;         /**< Buffer holding the latest merge */
+    uint8_t *merged_data;          /**< outputs[current_output].data */
+    uint64_t last_merge_time_us;   /**< Orders overlapping merges for LAST/LATEST ports */
     bool output_active;
+    atomic_bool dirty;             /**< Sources changed since the last merge */
+    uint16_t dirty_lo;             /**< Channels to recompute at the next */
+    uint16_t dirty_hi;             /**< merge: [dirty_lo, dirty_hi) */
+    int8_t selected_source;        /**< Slot copied by LAST/BACKUP/DISABLE */
+    
+    // Per-channel ownership (LATEST)
+    int8_t channel_owner[512];     /**< Slot that changed the channel last */
+    uint16_t latest_tick;          /**< Stamps change_tick, one per source merged */
+    uint32_t latest_pending_mask;  /**< Slots with pending_changes */
+    bool owners_stale;             /**< Reassign every channel at the next merge */
+    
+    // Output held between ArtSync latches
+    int8_t latched_output;         /**< Buffer held by the latch, or MERGE_OUTPUT_NONE */
+    bool latched_active;
+    atomic_bool sync_mode;         /**< Output only what the last latch held */
+    atomic_uint sync_time_ms;      /**< Time of the last latch (wraps) */
+    atomic_uint sync_timeout_ms;   /**< Back to immediate mode after this */
     
     // Statistics
     merge_stats_t stats;
+    atomic_uint slot_copies;       /**< Counted by the writers, lock-free */
     
     // Primary source index (for BACKUP mode)
     int8_t primary_source_index;
 } merge_context_t;
 
+/**
+ * @brief Output port: the merges it reads, composed on read
+ */
+typedef struct {
+    merge_subscription_t merges[MERGE_PORT_MERGES]; /**< Most preferred first */
+    uint8_t merge_count;
+    merge_mode_t mode;             /**< Combines overlapping merges */
+    SemaphoreHandle_t mutex;       /**< Guards the subscriptions and composing */
+    output_buffer_t frames[MERGE_PORT_FRAMES]; /**< Composed frames, lent like merged ones */
+} merge_port_t;
+
+/**
+ * @brief One merged frame held while a port composes it
+ */
+typedef struct {
+    output_buffer_t *output;
+    int16_t offset;
+    uint64_t merge_time_us;        /**< When the merge last ran */
+} port_input_t;
+
+/**
+ * @brief Interned source name
+ */
+typedef struct {
+    uint8_t refs;                  /**< Slots using the name, 0 = free */
+    char name[MERGE_SOURCE_NAME_LENGTH];
+} name_entry_t;
+
 /**
  * @brief Module state
  */
 static struct {
     bool initialized;
-    merge_context_t ports[2];      /**< Contexts for port 1 and 2 */
-    SemaphoreHandle_t mutex;
+    
+    // Source pool shared by all merges, one name per slot
+    merge_slot_t *pool;            /**< Internal RAM */
+    merge_slot_cold_t *pool_cold;  /**< PSRAM if enabled */
+    name_entry_t *names;           /**< PSRAM if enabled */
+    uint8_t pool_size;
+    uint32_t pool_free_mask;       /**< Unbound slots (bit per pool slot) */
+    SemaphoreHandle_t names_mutex; /**< Claims on all merges share the pool and names */
+    merge_context_t merges[MERGE_MAX_MERGES]; /**< Universe merges */
+    merge_port_t ports[MERGE_MAX_PORTS];
+    atomic_uint sync_mask;         /**< Merges in sync mode (bit per merge), read lock-free */
+    merge_expiry_callback_t expiry_callback;
+    void *expiry_user_data;
 } merge_state = {
     .initialized = false,
 };
 
 // Forward declarations
-static void perform_merge(merge_context_t *ctx);
-static void merge_htp(merge_context_t *ctx);
-static void merge_ltp(merge_context_t *ctx);
-static void merge_last(merge_context_t *ctx);
-static void merge_backup(merge_context_t *ctx);
-static void merge_disable(merge_context_t *ctx);
-static bool is_source_timeout(const dmx_source_data_t *source, uint64_t timeout_us);
-static int find_or_create_source(merge_context_t *ctx, uint32_t source_ip, 
-                                 source_protocol_t protocol);
-static void cleanup_timeout_sources(merge_context_t *ctx);
+static void perform_merge(merge_context_t *ctx, uint64_t now);
+static uint16_t merge_htp(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_ltp(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_last(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_backup(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_disable(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_per_channel(merge_context_t *ctx, uint16_t lo, uint16_t hi);
+static uint16_t merge_latest(merge_context_t *ctx, const uint32_t *changed,
+                             uint16_t lo, uint16_t hi);
+static void latest_apply_changes(merge_context_t *ctx, uint32_t *changed);
+static void latest_rebuild_owners(merge_context_t *ctx);
+static void build_spans(merge_context_t *ctx);
+static void update_channel_winners(merge_context_t *ctx);
+static merge_slot_t* find_source(merge_context_t *ctx, const source_key_t *key);
+static merge_slot_t* claim_source(merge_context_t *ctx, const source_key_t *key,
+                                  uint32_t source_ip, const char *source_name);
+static void refresh_sources(merge_context_t *ctx, uint64_t now);
 
 /**
  * @brief Get current time in microseconds
@@ -82,28 +388,106 @@ static inline uint64_t get_time_us(void)
 }
 
 /**
- * @brief Check if source has timed out
+ * @brief Widen a channel span; empty spans are (512, 0)
  */
-static bool is_source_timeout(const dmx_source_data_t *source, uint64_t timeout_us)
+static inline void span_union(uint16_t *lo, uint16_t *hi, uint16_t other_lo, uint16_t other_hi)
 {
-    if (!source->is_valid) {
-        return true;
+    if (other_lo < *lo) {
+        *lo = other_lo;
+    }
+    if (other_hi > *hi) {
+        *hi = other_hi;
+    }
+}
+
+/**
+ * @brief Mark a channel span for recompute at the next merge
+ */
+static inline void mark_span_dirty(merge_context_t *ctx, uint16_t lo, uint16_t hi)
+{
+    span_union(&ctx->dirty_lo, &ctx->dirty_hi, lo, hi);
+}
+
+/**
+ * @brief Mark every channel for recompute (source set or mode changed)
+ * 
+ * LATEST reassigns every channel's owner along with it.
+ */
+static inline void mark_all_dirty(merge_context_t *ctx)
+{
+    ctx->dirty_lo = 0;
+    ctx->dirty_hi = 512;
+    ctx->owners_stale = true;
+}
+
+/**
+ * @brief Slot bound at a merge index, NULL if none (merger side, merge mutex held)
+ */
+static inline merge_slot_t* slot_at(const merge_context_t *ctx, int index)
+{
+    return atomic_load_explicit(&ctx->sources[index], memory_order_relaxed);
+}
+
+/**
+ * @brief Front frame of a slot (merger side only)
+ */
+static inline const merge_frame_t* slot_front(const merge_slot_t *slot)
+{
+    return &slot->frames[slot->front];
+}
+
+/**
+ * @brief Reset slot buffers to the initial triple-buffer layout
+ */
+static void slot_reset(merge_slot_t *slot)
+{
+    memset(slot->frames, 0, sizeof(slot->frames));
+    slot->back = 0;
+    slot->published = SLOT_NONE;
+    slot->extent = 0;
+    atomic_store(&slot->middle, 1);
+    slot->front = 2;
+    slot->is_valid = false;
+    slot->terminated = false;
+}
+
+/**
+ * @brief Publish the writer's back frame (writer side only)
+ */
+static void slot_publish(merge_slot_t *slot)
+{
+    slot->published = slot->back;
+    uint32_t old = atomic_exchange_explicit(&slot->middle, slot->back | SLOT_FRESH,
+                                            memory_order_acq_rel);
+    slot->back = old & SLOT_INDEX_MASK;
+}
+
+/**
+ * @brief Take the latest published frame, if any (merger side only)
+ * 
+ * @return true if a new frame was taken
+ */
+static bool slot_acquire(merge_slot_t *slot)
+{
+    if (!(atomic_load_explicit(&slot->middle, memory_order_acquire) & SLOT_FRESH)) {
+        return false;
     }
     
-    uint64_t now = get_time_us();
-    uint64_t elapsed = now - source->timestamp_us;
-    
-    return elapsed > timeout_us;
+    uint32_t old = atomic_exchange_explicit(&slot->middle, slot->front,
+                                            memory_order_acq_rel);
+    slot->front = old & SLOT_INDEX_MASK;
+    return true;
 }
 
 /**
- * @brief Count active (non-timeout) sources
+ * @brief Count active sources (valid as of the last refresh)
  */
 static uint8_t count_active_sources(merge_context_t *ctx)
 {
     uint8_t count = 0;
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        const merge_slot_t *slot = slot_at(ctx, i);
+        if (slot && slot->is_valid) {
             count++;
         }
     }
@@ -111,302 +495,1627 @@ static uint8_t count_active_sources(merge_context_t *ctx)
 }
 
 /**
- * @brief Find or create source entry
+ * @brief Pull the merge's deadline in to an expiry time (merge mutex held)
  */
-static int find_or_create_source(merge_context_t *ctx, uint32_t source_ip,
-                                source_protocol_t protocol)
+static inline void expiry_at(merge_context_t *ctx, uint64_t expiry_us)
 {
-    // Try to find existing source by IP and protocol
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (ctx->sources[i].source_ip == source_ip &&
-            ctx->sources[i].protocol == protocol) {
-            return i;
-        }
+    if (expiry_us < ctx->next_expiry_us) {
+        ctx->next_expiry_us = expiry_us;
     }
+}
+
+/**
+ * @brief Rebuild the top-priority set from scratch
+ * 
+ * Only needed when the top set empties or a member drops its priority.
+ */
+static void priority_rescan(merge_context_t *ctx)
+{
+    ctx->priority_mask = 0;
+    ctx->top_priority = 0;
     
-    // Try to reuse timeout source slot
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            // Reuse this slot
-            memset(&ctx->sources[i], 0, sizeof(dmx_source_data_t));
-            return i;
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        const merge_slot_t *slot = slot_at(ctx, i);
+        if (!slot || !slot->is_valid) {
+            continue;
+        }
+        if (ctx->priority_mask == 0 || slot->priority > ctx->top_priority) {
+            ctx->top_priority = slot->priority;
+            ctx->priority_mask = 1UL << i;
+        } else if (slot->priority == ctx->top_priority) {
+            ctx->priority_mask |= 1UL << i;
         }
     }
-    
-    // Create new source if space available
-    if (ctx->source_count < MERGE_MAX_SOURCES) {
-        int index = ctx->source_count;
-        ctx->source_count++;
-        memset(&ctx->sources[index], 0, sizeof(dmx_source_data_t));
-        return index;
-    }
-    
-    return -1;  // No space available
 }
 
 /**
- * @brief Cleanup timeout sources
+ * @brief Account for a source that became valid or changed priority
  */
-static void cleanup_timeout_sources(merge_context_t *ctx)
+static void priority_source_updated(merge_context_t *ctx, int index)
 {
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            if (ctx->sources[i].is_valid) {
-                ctx->stats.source_timeouts++;
-                ctx->sources[i].is_valid = false;
-            }
-        }
+    uint32_t bit = 1UL << index;
+    uint8_t priority = slot_at(ctx, index)->priority;
+    
+    ctx->channel_winners_stale = true;
+    mark_all_dirty(ctx);
+    
+    if (ctx->priority_mask == 0 || priority > ctx->top_priority) {
+        ctx->top_priority = priority;
+        ctx->priority_mask = bit;
+    } else if (priority == ctx->top_priority) {
+        ctx->priority_mask |= bit;
+    } else if (ctx->priority_mask & bit) {
+        // A top source lowered its priority - someone else may now lead
+        priority_rescan(ctx);
     }
 }
 
 /**
- * @brief Get port context
+ * @brief Account for a source that timed out or was invalidated
  */
-static merge_context_t* get_port_context(uint8_t port)
+static void priority_source_removed(merge_context_t *ctx, int index)
 {
-    if (port < 1 || port > 2) {
-        return NULL;
+    uint32_t bit = 1UL << index;
+    
+    ctx->channel_winners_stale = true;
+    mark_all_dirty(ctx);
+    
+    if (ctx->priority_mask & bit) {
+        ctx->priority_mask &= ~bit;
+        if (ctx->priority_mask == 0) {
+            priority_rescan(ctx);
+        }
     }
-    return &merge_state.ports[port - 1];
 }
 
-// ============================================================================
-// Public API Implementation
-// ============================================================================
-
-esp_err_t merge_engine_init(void)
+/**
+ * @brief Take a reference on a source name, adding it to the table if new
+ * 
+ * The name may fill its field without a terminator (sACN source names).
+ * 
+ * @return Name handle, MERGE_NAME_NONE if the table is full
+ */
+static uint8_t name_intern(const char *name)
 {
-    if (merge_state.initialized) {
-        ESP_LOGW(TAG, "Already initialized");
-        return ESP_ERR_INVALID_STATE;
-    }
+    size_t length = strnlen(name, MERGE_SOURCE_NAME_LENGTH - 1);
+    uint8_t id = MERGE_NAME_NONE;
     
-    ESP_LOGI(TAG, "Initializing merge engine...");
+    xSemaphoreTake(merge_state.names_mutex, portMAX_DELAY);
     
-    // Create mutex
-    merge_state.mutex = xSemaphoreCreateMutex();
-    if (!merge_state.mutex) {
-        ESP_LOGE(TAG, "Failed to create mutex");
-        return ESP_ERR_NO_MEM;
+    for (int i = 0; i < merge_state.pool_size; i++) {
+        name_entry_t *entry = &merge_state.names[i];
+        if (entry->refs && strncmp(entry->name, name, length) == 0 &&
+            entry->name[length] == '\0') {
+            id = i;
+            break;
+        }
+        if (!entry->refs && id == MERGE_NAME_NONE) {
+            id = i;
+        }
     }
     
-    // Initialize port contexts
-    for (int i = 0; i < 2; i++) {
-        merge_context_t *ctx = &merge_state.ports[i];
-        memset(ctx, 0, sizeof(merge_context_t));
-        ctx->port_num = i + 1;
-        ctx->mode = MERGE_MODE_HTP;  // Default mode
-        ctx->timeout_us = MERGE_DEFAULT_TIMEOUT_US;
-        ctx->primary_source_index = -1;
-        ctx->output_active = false;
+    if (id != MERGE_NAME_NONE) {
+        name_entry_t *entry = &merge_state.names[id];
+        if (!entry->refs) {
+            memcpy(entry->name, name, length);
+            entry->name[length] = '\0';
+        }
+        entry->refs++;
     }
     
-    merge_state.initialized = true;
-    ESP_LOGI(TAG, "Merge engine initialized successfully");
+    xSemaphoreGive(merge_state.names_mutex);
     
-    return ESP_OK;
+    return id;
 }
 
-esp_err_t merge_engine_deinit(void)
+/**
+ * @brief Drop a reference on a source name
+ */
+static void name_release(uint8_t id)
 {
-    if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
+    if (id >= merge_state.pool_size) {
+        return;
     }
     
-    ESP_LOGI(TAG, "Deinitializing merge engine...");
-    
-    // Delete mutex
-    if (merge_state.mutex) {
-        vSemaphoreDelete(merge_state.mutex);
-        merge_state.mutex = NULL;
+    xSemaphoreTake(merge_state.names_mutex, portMAX_DELAY);
+    if (merge_state.names[id].refs) {
+        merge_state.names[id].refs--;
     }
-    
-    merge_state.initialized = false;
-    ESP_LOGI(TAG, "Merge engine deinitialized");
-    
-    return ESP_OK;
+    xSemaphoreGive(merge_state.names_mutex);
 }
 
-esp_err_t merge_engine_config(uint8_t port, merge_mode_t mode, uint32_t timeout_ms)
+/**
+ * @brief Take a free slot from the pool, NULL if it is empty
+ */
+static merge_slot_t* pool_take(void)
 {
-    if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
-    }
+    merge_slot_t *slot = NULL;
     
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx) {
-        return ESP_ERR_INVALID_ARG;
+    xSemaphoreTake(merge_state.names_mutex, portMAX_DELAY);
+    if (merge_state.pool_free_mask) {
+        int i = __builtin_ctz(merge_state.pool_free_mask);
+        merge_state.pool_free_mask &= ~(1UL << i);
+        slot = &merge_state.pool[i];
     }
+    xSemaphoreGive(merge_state.names_mutex);
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    
-    ctx->mode = mode;
+    return slot;
+}
+
+/**
+ * @brief Unbind a silent source's slot and give it back to the pool (merge mutex held)
+ * 
+ * Only called once the source has been silent for the timeout, like any
+ * slot recycling, so no writer still holds the slot.
+ */
+static void source_release(merge_context_t *ctx, int index)
+{
+    merge_slot_t *slot = slot_at(ctx, index);
+    uint32_t bit = 1UL << index;
     
-    if (timeout_ms > 0) {
-        ctx->timeout_us = timeout_ms * 1000;
-    } else {
-        ctx->timeout_us = MERGE_DEFAULT_TIMEOUT_US;
+    if (slot->is_valid) {
+        slot->is_valid = false;
+        priority_source_removed(ctx, index);
     }
-    
-    ESP_LOGI(TAG, "Port %d configured: mode=%d, timeout=%lu ms", 
-             port, mode, ctx->timeout_us / 1000);
-    
-    xSemaphoreGive(merge_state.mutex);
-    
-    return ESP_OK;
+    ctx->channel_map_mask &= ~bit;
+    ctx->latest_pending_mask &= ~bit;
+    ctx->channel_winners_stale = true;
+    
+    atomic_store_explicit(&slot->in_use, false, memory_order_release);
+    atomic_store_explicit(&ctx->sources[index], NULL, memory_order_release);
+    name_release(slot->name_id);
+    slot->name_id = MERGE_NAME_NONE;
+    
+    xSemaphoreTake(merge_state.names_mutex, portMAX_DELAY);
+    merge_state.pool_free_mask |= 1UL << (slot - merge_state.pool);
+    xSemaphoreGive(merge_state.names_mutex);
 }
 
-esp_err_t merge_engine_push_artnet(uint8_t port, uint16_t universe,
-                                   const uint8_t *data, uint8_t sequence,
-                                   uint32_t source_ip)
+/**
+ * @brief Count a push refused because the pool is full, warning now and then
+ */
+static void source_overflow(merge_context_t *ctx)
 {
-    if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
+    uint32_t count = atomic_fetch_add_explicit(&ctx->source_overflows, 1,
+                                               memory_order_relaxed) + 1;
+                                               
+    // Whichever writer wins the exchange logs; the others only count
+    uint32_t now_ms = (uint32_t)(get_time_us() / 1000);
+    uint32_t last_ms = atomic_load_explicit(&ctx->overflow_log_ms, memory_order_relaxed);
+    if ((count == 1 || now_ms - last_ms >= MERGE_OVERFLOW_LOG_INTERVAL_MS) &&
+        atomic_compare_exchange_strong(&ctx->overflow_log_ms, &last_ms, now_ms)) {
+        ESP_LOGW(TAG, "Merge %d: source pool full (%d slots), %" PRIu32 " packets dropped",
+                 ctx->merge_num, merge_state.pool_size, count);
     }
-    
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx || !data) {
-        return ESP_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief Find an existing source slot without locking (writer side)
+ */
+static merge_slot_t* find_source(merge_context_t *ctx, const source_key_t *key)
+{
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        merge_slot_t *slot = atomic_load_explicit(&ctx->sources[i], memory_order_acquire);
+        if (slot && atomic_load_explicit(&slot->in_use, memory_order_acquire) &&
+            slot->key.source_ip == key->source_ip && slot->key.protocol == key->protocol &&
+            slot->key.universe == key->universe &&
+            memcmp(slot->key.cid, key->cid, MERGE_CID_LENGTH) == 0) {
+            return slot;
+        }
     }
+    return NULL;
+}
+
+/**
+ * @brief Claim a slot for a new source
+ * 
+ * Slow path, taken once per source under the merge mutex. A slot is only
+ * recycled after its previous owner has been silent for the full timeout,
+ * which keeps the one-writer-per-slot rule intact. A free pool slot is
+ * preferred; with the pool empty only a source that terminated its stream
+ * is replaced in place. Sources that merely have no frame merged yet (just
+ * claimed, or blacked out) keep their slot, and the push is refused.
+ */
+static merge_slot_t* claim_source(merge_context_t *ctx, const source_key_t *key,
+                                  uint32_t source_ip, const char *source_name)
+{
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
+    // Another push may have claimed it while we waited
+    merge_slot_t *slot = find_source(ctx, key);
+    if (slot) {
+        xSemaphoreGive(ctx->mutex);
+        return slot;
+    }
     
-    // Find or create source
-    int source_idx = find_or_create_source(ctx, source_ip, SOURCE_PROTOCOL_ARTNET);
-    if (source_idx < 0) {
-        ESP_LOGW(TAG, "Port %d: Maximum sources reached", port);
-        xSemaphoreGive(merge_state.mutex);
-        return ESP_ERR_NO_MEM;
+    // Free index of this port and a pool slot; timed out sources go back
+    // to the pool in refresh_sources
+    uint64_t now = get_time_us();
+    refresh_sources(ctx, now);
+    int index = -1;
+    for (int i = 0; i < MERGE_MAX_SOURCES && index < 0; i++) {
+        if (!slot_at(ctx, i)) {
+            index = i;
+        }
+    }
+    if (index >= 0) {
+        slot = pool_take();
+    }
+    if (!slot) {
+        for (int i = 0; i < MERGE_MAX_SOURCES && !slot; i++) {
+            if (slot_at(ctx, i) && slot_at(ctx, i)->terminated) {
+                slot = slot_at(ctx, i);
+                index = i;
+            }
+        }
     }
     
-    // Update source data
-    dmx_source_data_t *source = &ctx->sources[source_idx];
-    memcpy(source->data, data, 512);
-    source->timestamp_us = get_time_us();
-    source->sequence = sequence;
-    source->priority = 100;  // Default priority for Art-Net
-    snprintf(source->source_name, sizeof(source->source_name), "ArtNet_%08" PRIX32, source_ip);
-    source->source_ip = source_ip;
-    source->protocol = SOURCE_PROTOCOL_ARTNET;
-    source->is_valid = true;
+    if (slot) {
+        // A recycled slot must not carry the previous owner's 0xDD map
+        ctx->channel_map_mask &= ~(1UL << index);
+        ctx->channel_winners_stale = true;
+        
+        atomic_store(&slot->in_use, false);
+        slot_reset(slot);
+        slot->index = index;
+        slot->key = *key;
+        
+        // Counts as heard from now, so it is not released before its first frame
+        slot->frames[slot->front].timestamp_us = now;
+        expiry_at(ctx, now + ctx->timeout_us);
+        
+        // A new source has never changed a channel: oldest possible stamps
+        ctx->latest_pending_mask &= ~(1UL << index);
+        memset(slot->pending_changes, 0, sizeof(slot->pending_changes));
+        for (int ch = 0; ch < 512; ch++) {
+            slot->change_tick[ch] = ctx->latest_tick - LATEST_AGE_LIMIT;
+        }
+        
+        slot->source_ip = source_ip;
+        name_release(slot->name_id);
+        slot->name_id = name_intern(source_name);
+        atomic_store_explicit(&slot->in_use, true, memory_order_release);
+        atomic_store_explicit(&ctx->sources[index], slot, memory_order_release);
+    }
     
-    xSemaphoreGive(merge_state.mutex);
+    xSemaphoreGive(ctx->mutex);
     
-    return ESP_OK;
+    return slot;
 }
 
-esp_err_t merge_engine_push_sacn(uint8_t port, uint16_t universe,
-                                 const uint8_t *data, uint8_t sequence,
-                                 uint8_t priority, const char *source_name,
-                                 uint32_t source_ip)
+/**
+ * @brief Bitmap of the channels in [lo, hi) where two frames differ
+ */
+static void diff_channels(uint32_t *changed, const uint8_t *data, const uint8_t *prev,
+                          uint16_t lo, uint16_t hi)
 {
-    if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
+    memset(changed, 0, CHANNEL_MAP_WORDS * sizeof(uint32_t));
+    for (int ch = lo; ch < hi; ch++) {
+        if (data[ch] != prev[ch]) {
+            changed[ch >> 5] |= 1UL << (ch & 31);
+        }
     }
-    
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx || !data) {
-        return ESP_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief Write one frame into a source slot and publish it
+ */
+static esp_err_t push_frame(merge_context_t *ctx, const source_key_t *key, uint32_t source_ip,
+                            const char *source_name, const uint8_t *data, uint16_t length,
+                            uint32_t sequence, uint8_t priority)
+{
+    merge_slot_t *slot = find_source(ctx, key);
+    if (!slot) {
+        slot = claim_source(ctx, key, source_ip, source_name);
+        if (!slot) {
+            source_overflow(ctx);
+            return ESP_ERR_NO_MEM;
+        }
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    
-    // Find or create source
-    int source_idx = find_or_create_source(ctx, source_ip, SOURCE_PROTOCOL_SACN);
-    if (source_idx < 0) {
-        ESP_LOGW(TAG, "Port %d: Maximum sources reached", port);
-        xSemaphoreGive(merge_state.mutex);
-        return ESP_ERR_NO_MEM;
+    // Previous frame is read-only here and still ours to read
+    const merge_frame_t *prev = NULL;
+    if (slot->published != SLOT_NONE) {
+        prev = &slot->frames[slot->published];
     }
     
-    // Update source data
-    dmx_source_data_t *source = &ctx->sources[source_idx];
-    memcpy(source->data, data, 512);
-    source->timestamp_us = get_time_us();
-    source->sequence = sequence;
-    source->priority = priority;
-    if (source_name) {
-        strncpy(source->source_name, source_name, sizeof(source->source_name) - 1);
-        source->source_name[sizeof(source->source_name) - 1] = '\0';
-    } else {
-        snprintf(source->source_name, sizeof(source->source_name), "sACN_%08" PRIX32, source_ip);
+    // Only the received channels are copied. Channels in [length, extent)
+    // came from an earlier, longer frame; beyond extent every buffer is still 0
+    uint16_t extent = (length > slot->extent) ? length : slot->extent;
+    merge_frame_t *frame = &slot->frames[slot->back];
+    
+    memcpy(frame->data, data, length);
+    atomic_fetch_add_explicit(&ctx->slot_copies, 1, memory_order_relaxed);
+    if (length < extent) {
+        if (ctx->short_frame_policy == SHORT_FRAME_ZERO || !prev) {
+            memset(frame->data + length, 0, extent - length);
+        } else {
+            memcpy(frame->data + length, prev->data + length, extent - length);
+        }
+    }
+    slot->extent = extent;
+    
+    // Span that differs from the previous frame; LATEST also needs the
+    // exact channels (read unlocked, a mode change re-merges everything)
+    bool track = ctx->latest_in_use;
+    bool has_changes = false;
+    uint16_t lo = 0;
+    uint16_t hi = 512;
+    if (prev) {
+        lo = 0;
+        hi = extent;
+        while (lo < hi && frame->data[lo] == prev->data[lo]) {
+            lo++;
+        }
+        while (hi > lo && frame->data[hi - 1] == prev->data[hi - 1]) {
+            hi--;
+        }
+        if (lo == hi) {
+            lo = 512;
+            hi = 0;
+        }
+        
+        if (track) {
+            diff_channels(frame->changed, frame->data, prev->data, lo, hi);
+            has_changes = true;
+        }
+        
+        // Merger has not taken the previous frame - carry its span forward.
+        // If it takes it right after this check the span is merely wider.
+        if (atomic_load_explicit(&slot->middle, memory_order_acquire) & SLOT_FRESH) {
+            span_union(&lo, &hi, prev->dirty_lo, prev->dirty_hi);
+            if (has_changes && prev->has_changes) {
+                for (int w = 0; w < CHANNEL_MAP_WORDS; w++) {
+                    frame->changed[w] |= prev->changed[w];
+                }
+            } else {
+                has_changes = false;
+            }
+        }
     }
-    source->source_ip = source_ip;
-    source->protocol = SOURCE_PROTOCOL_SACN;
-    source->is_valid = true;
     
-    xSemaphoreGive(merge_state.mutex);
+    frame->has_changes = has_changes;
+    frame->timestamp_us = get_time_us();
+    frame->sequence = sequence;
+    frame->priority = priority;
+    frame->dirty_lo = lo;
+    frame->dirty_hi = hi;
+    
+    slot_publish(slot);
+    atomic_fetch_or_explicit(&ctx->fresh_mask, 1UL << slot->index, memory_order_release);
+    atomic_store(&ctx->dirty, true);
     
     return ESP_OK;
 }
 
-esp_err_t merge_engine_push_dmx_in(uint8_t port, const uint8_t *data)
+/**
+ * @brief Queue the channels a taken frame changed for the next LATEST merge
+ * 
+ * A source coming back after a timeout or termination takes every channel,
+ * like a new one. Frames pushed before LATEST was selected carry no
+ * bitmap; their whole dirty span counts as changed.
+ */
+static void latest_record_changes(merge_context_t *ctx, int index, const merge_frame_t *frame)
 {
-    if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
+    merge_slot_t *slot = slot_at(ctx, index);
+    
+    if (!slot->is_valid) {
+        memset(slot->pending_changes, 0xFF, sizeof(slot->pending_changes));
+    } else if (frame->has_changes) {
+        for (int w = 0; w < CHANNEL_MAP_WORDS; w++) {
+            slot->pending_changes[w] |= frame->changed[w];
+        }
+    } else {
+        for (int ch = frame->dirty_lo; ch < frame->dirty_hi; ch++) {
+            slot->pending_changes[ch >> 5] |= 1UL << (ch & 31);
+        }
+    }
+    
+    ctx->latest_pending_mask |= 1UL << index;
+}
+
+/**
+ * @brief Expire silent sources and stale 0xDD maps, then find the next deadline
+ * 
+ * Times are compared as deadlines: a frame taken after the snapshot may
+ * be stamped later than now.
+ */
+static void expire_sources(merge_context_t *ctx, uint64_t now)
+{
+    uint64_t next = UINT64_MAX;
+    uint8_t expired = 0;
+    
+    ctx->stats.expiry_scans++;
+    
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        merge_slot_t *slot = slot_at(ctx, i);
+        if (!slot) {
+            continue;
+        }
+        
+        // Silent for the timeout: the slot goes back to the pool (a
+        // terminated source has already been invalidated)
+        uint64_t expiry = slot_front(slot)->timestamp_us + ctx->timeout_us;
+        if (now > expiry) {
+            if (slot->is_valid) {
+                ctx->stats.source_timeouts++;
+                expired++;
+                atomic_store(&ctx->dirty, true);
+            }
+            source_release(ctx, i);
+            continue;
+        }
+        if (expiry < next) {
+            next = expiry;
+        }
+        
+        // A source that stops sending 0xDD falls back to its packet priority
+        if (ctx->channel_map_mask & (1UL << i)) {
+            uint64_t map_expiry = slot->cold->channel_priority_time_us + ctx->timeout_us;
+            if (now > map_expiry) {
+                ctx->channel_map_mask &= ~(1UL << i);
+                ctx->channel_winners_stale = true;
+                mark_all_dirty(ctx);
+                atomic_store(&ctx->dirty, true);
+            } else if (map_expiry < next) {
+                next = map_expiry;
+            }
+        }
+    }
+    
+    ctx->next_expiry_us = next;
+    
+    if (expired && merge_state.expiry_callback) {
+        merge_state.expiry_callback(ctx->merge_num, expired, count_active_sources(ctx),
+                                    merge_state.expiry_user_data);
+    }
+}
+
+/**
+ * @brief Pull fresh frames and expire timed out sources (merger side only)
+ * 
+ * Keeps the top-priority set in step with arrivals, priority changes and
+ * timeouts. Only slots flagged fresh are looked at, and the sources are
+ * only scanned for expiry once the merge's deadline has passed.
+ * 
+ * @param now Time snapshot of the caller
+ */
+static void refresh_sources(merge_context_t *ctx, uint64_t now)
+{
+    uint32_t fresh = atomic_exchange_explicit(&ctx->fresh_mask, 0, memory_order_acquire);
+    
+    while (fresh) {
+        int i = __builtin_ctz(fresh);
+        fresh &= fresh - 1;
+        
+        merge_slot_t *slot = slot_at(ctx, i);
+        if (!slot || !slot_acquire(slot)) {
+            continue;
+        }
+        
+        // A newer frame only moves the source's expiry later
+        const merge_frame_t *frame = slot_front(slot);
+        if (ctx->latest_in_use) {
+            latest_record_changes(ctx, i, frame);
+        }
+        slot->terminated = false;
+        if (!slot->is_valid || frame->priority != slot->priority) {
+            slot->is_valid = true;
+            slot->priority = frame->priority;
+            priority_source_updated(ctx, i);
+        } else {
+            mark_span_dirty(ctx, frame->dirty_lo, frame->dirty_hi);
+        }
+    }
+    
+    if (now >= ctx->next_expiry_us) {
+        expire_sources(ctx, now);
+    }
+}
+
+/**
+ * @brief Rebuild the per-channel winner bitmaps from the 0xDD maps
+ * 
+ * Runs only after a 0xDD frame or a change in the source set, never per
+ * level frame. Sources without a map compete on every channel with their
+ * packet priority; a map entry of 0 means the source does not drive that
+ * channel.
+ */
+static void update_channel_winners(merge_context_t *ctx)
+{
+    memset(ctx->channel_winners, 0, sizeof(ctx->channel_winners));
+    
+    for (int ch = 0; ch < 512; ch++) {
+        int top = -1;
+        uint32_t winners = 0;
+        
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            const merge_slot_t *slot = slot_at(ctx, i);
+            if (!slot || !slot->is_valid) {
+                continue;
+            }
+            
+            int level = slot->priority;
+            if (ctx->channel_map_mask & (1UL << i)) {
+                level = slot->cold->channel_priority[ch];
+                if (level == 0) {
+                    continue;
+                }
+            }
+            
+            if (level > top) {
+                top = level;
+                winners = 1UL << i;
+            } else if (level == top) {
+                winners |= 1UL << i;
+            }
+        }
+        
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            if (winners & (1UL << i)) {
+                ctx->channel_winners[i][ch >> 5] |= 1UL << (ch & 31);
+            }
+        }
+    }
+    
+    ctx->channel_winners_stale = false;
+}
+
+/**
+ * @brief Get the context of a merge
+ */
+static merge_context_t* get_merge_context(uint8_t merge)
+{
+    if (merge < 1 || merge > MERGE_MAX_MERGES) {
+        return NULL;
+    }
+    return &merge_state.merges[merge - 1];
+}
+
+/**
+ * @brief Get a port
+ */
+static merge_port_t* get_port(uint8_t port)
+{
+    if (port < 1 || port > MERGE_MAX_PORTS) {
+        return NULL;
+    }
+    return &merge_state.ports[port - 1];
+}
+
+/**
+ * @brief Whether a merge's output is held to its last sync latch
+ * 
+ * Leaves sync mode once the last latch is older than the sync timeout.
+ */
+static bool is_sync_active(merge_context_t *ctx)
+{
+    if (!atomic_load(&ctx->sync_mode)) {
+        return false;
+    }
+    
+    uint32_t now_ms = (uint32_t)(get_time_us() / 1000);
+    uint32_t timeout_ms = atomic_load(&ctx->sync_timeout_ms);
+    if (now_ms - atomic_load(&ctx->sync_time_ms) < timeout_ms) {
+        return true;
+    }
+    
+    if (atomic_exchange(&ctx->sync_mode, false)) {
+        int merge = (int)(ctx - merge_state.merges) + 1;
+        atomic_fetch_and(&merge_state.sync_mask, ~(1u << (merge - 1)));
+        ESP_LOGI(TAG, "Merge %d: no sync for %" PRIu32 " ms, back to immediate output",
+                 merge, timeout_ms);
+    }
+    return false;
+}
+
+/**
+ * @brief Build the key of an sACN source
+ * 
+ * Keyed by CID; the IP only stands in when no CID is known.
+ */
+static void make_sacn_key(source_key_t *key, uint16_t universe, const uint8_t *cid,
+                          uint32_t source_ip)
+{
+    memset(key, 0, sizeof(source_key_t));
+    key->protocol = SOURCE_PROTOCOL_SACN;
+    key->universe = universe;
+    
+    if (cid) {
+        memcpy(key->cid, cid, MERGE_CID_LENGTH);
+    } else {
+        key->source_ip = source_ip;
+    }
+}
+
+/**
+ * @brief Find a merged or composed output buffer by its data pointer
+ */
+static output_buffer_t* find_output(const uint8_t *data)
+{
+    for (int i = 0; i < MERGE_MAX_MERGES; i++) {
+        merge_context_t *ctx = &merge_state.merges[i];
+        for (int b = 0; b < MERGE_OUTPUT_BUFFERS; b++) {
+            if (ctx->outputs[b].data == data) {
+                return &ctx->outputs[b];
+            }
+        }
+    }
+    for (int i = 0; i < MERGE_MAX_PORTS; i++) {
+        merge_port_t *port = &merge_state.ports[i];
+        for (int b = 0; b < MERGE_PORT_FRAMES; b++) {
+            if (port->frames[b].data == data) {
+                return &port->frames[b];
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Make the current output buffer writable (merge mutex held)
+ * 
+ * While an output or the latch holds the current frame, the merge moves to
+ * a free buffer. Only channels outside [lo, hi), which the merge is about to
+ * rewrite, are carried over; an empty span carries over the whole frame.
+ */
+static void output_prepare(merge_context_t *ctx, uint16_t lo, uint16_t hi)
+{
+    output_buffer_t *current = &ctx->outputs[ctx->current_output];
+    if (atomic_load(&current->refs) == 0) {
+        return;
+    }
+    
+    // Refs only grow under the merge mutex, so a free buffer stays free
+    for (int b = 0; b < MERGE_OUTPUT_BUFFERS; b++) {
+        output_buffer_t *next = &ctx->outputs[b];
+        if (b != ctx->current_output && atomic_load(&next->refs) == 0) {
+            memcpy(next->data, current->data, lo);
+            memcpy(next->data + hi, current->data + hi, 512 - hi);
+            ctx->current_output = b;
+            ctx->merged_data = next->data;
+            ctx->stats.output_cow_copies++;
+            return;
+        }
+    }
+    
+    // Unreachable while every acquire is paired with a release
+    ESP_LOGE(TAG, "Merge %d: no free output buffer", ctx->merge_num);
+}
+
+/**
+ * @brief Drop the latch's hold on its frame (merge mutex held)
+ */
+static void latch_release(merge_context_t *ctx)
+{
+    if (ctx->latched_output != MERGE_OUTPUT_NONE) {
+        atomic_fetch_sub(&ctx->outputs[ctx->latched_output].refs, 1);
+        ctx->latched_output = MERGE_OUTPUT_NONE;
+    }
+    ctx->latched_active = false;
+}
+
+/**
+ * @brief Rebuild the spans from the merge mode and the channel-mode map (merge mutex held)
+ */
+static void build_spans(merge_context_t *ctx)
+{
+    uint8_t map[512];
+    memset(map, ctx->mode, sizeof(map));
+    for (int r = 0; r < ctx->mode_range_count; r++) {
+        const channel_mode_range_t *range = &ctx->mode_ranges[r];
+        uint16_t end = (range->count < 512 - range->start) ? range->start + range->count : 512;
+        memset(map + range->start, range->mode, end - range->start);
+    }
+    
+    bool latest_in_use = false;
+    ctx->span_count = 0;
+    for (int ch = 0; ch < 512; ) {
+        merge_span_t *span = &ctx->spans[ctx->span_count++];
+        span->lo = ch;
+        span->mode = map[ch];
+        while (ch < 512 && map[ch] == span->mode) {
+            ch++;
+        }
+        span->hi = ch;
+        latest_in_use |= (span->mode == MERGE_MODE_LATEST);
+    }
+    ctx->span = &ctx->spans[0];
+    
+    // Changes queued under an earlier LATEST period are long past
+    if (latest_in_use && !ctx->latest_in_use) {
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            merge_slot_t *slot = slot_at(ctx, i);
+            if (slot) {
+                memset(slot->pending_changes, 0, sizeof(slot->pending_changes));
+            }
+        }
+        ctx->latest_pending_mask = 0;
+    }
+    ctx->latest_in_use = latest_in_use;
+    
+    mark_all_dirty(ctx);
+    atomic_store(&ctx->dirty, true);
+}
+
+/**
+ * @brief Check a channel offset (a shift of 512 or more leaves nothing)
+ */
+static inline bool is_valid_offset(int16_t offset)
+{
+    return offset > -512 && offset < 512;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+/**
+ * @brief Allocate rarely used state, in PSRAM if asked and available
+ */
+static void* cold_calloc(size_t count, size_t size, bool psram)
+{
+    void *ptr = NULL;
+    if (psram) {
+        ptr = heap_caps_calloc(count, size, MALLOC_CAP_SPIRAM);
+    }
+    if (!ptr) {
+        ptr = heap_caps_calloc(count, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    return ptr;
+}
+
+/**
+ * @brief Free the source pool
+ */
+static void pool_destroy(void)
+{
+    heap_caps_free(merge_state.pool);
+    heap_caps_free(merge_state.pool_cold);
+    heap_caps_free(merge_state.names);
+    merge_state.pool = NULL;
+    merge_state.pool_cold = NULL;
+    merge_state.names = NULL;
+    merge_state.pool_size = 0;
+    merge_state.pool_free_mask = 0;
+}
+
+/**
+ * @brief Allocate the source pool: slots in internal RAM, cold state as asked
+ */
+static esp_err_t pool_create(uint8_t size, bool cold_in_psram)
+{
+    merge_state.pool = heap_caps_calloc(size, sizeof(merge_slot_t),
+                                        MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    merge_state.pool_cold = cold_calloc(size, sizeof(merge_slot_cold_t), cold_in_psram);
+    merge_state.names = cold_calloc(size, sizeof(name_entry_t), cold_in_psram);
+    if (!merge_state.pool || !merge_state.pool_cold || !merge_state.names) {
+        pool_destroy();
+        return ESP_ERR_NO_MEM;
+    }
+    
+    for (int i = 0; i < size; i++) {
+        merge_slot_t *slot = &merge_state.pool[i];
+        slot_reset(slot);
+        slot->name_id = MERGE_NAME_NONE;
+        slot->cold = &merge_state.pool_cold[i];
+    }
+    merge_state.pool_size = size;
+    merge_state.pool_free_mask = (size < 32) ? (1UL << size) - 1 : UINT32_MAX;
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Delete the mutexes created so far
+ */
+static void destroy_mutexes(void)
+{
+    for (int i = 0; i < MERGE_MAX_MERGES; i++) {
+        if (merge_state.merges[i].mutex) {
+            vSemaphoreDelete(merge_state.merges[i].mutex);
+            merge_state.merges[i].mutex = NULL;
+        }
+    }
+    for (int i = 0; i < MERGE_MAX_PORTS; i++) {
+        if (merge_state.ports[i].mutex) {
+            vSemaphoreDelete(merge_state.ports[i].mutex);
+            merge_state.ports[i].mutex = NULL;
+        }
+    }
+    if (merge_state.names_mutex) {
+        vSemaphoreDelete(merge_state.names_mutex);
+        merge_state.names_mutex = NULL;
+    }
+}
+
+esp_err_t merge_engine_init(const merge_pool_config_t *config)
+{
+    if (merge_state.initialized) {
+        ESP_LOGW(TAG, "Already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_pool_config_t pool = {
+        .sources = MERGE_DEFAULT_POOL_SOURCES,
+        .cold_in_psram = true,
+    };
+    if (config) {
+        pool = *config;
+    }
+    if (pool.sources == 0 || pool.sources > MERGE_POOL_MAX_SOURCES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ESP_LOGI(TAG, "Initializing merge engine...");
+    
+    merge_state.names_mutex = xSemaphoreCreateMutex();
+    if (!merge_state.names_mutex) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (pool_create(pool.sources, pool.cold_in_psram) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to allocate pool of %d sources", pool.sources);
+        vSemaphoreDelete(merge_state.names_mutex);
+        merge_state.names_mutex = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Initialize merge contexts
+    atomic_store(&merge_state.sync_mask, 0);
+    for (int i = 0; i < MERGE_MAX_MERGES; i++) {
+        merge_context_t *ctx = &merge_state.merges[i];
+        memset(ctx, 0, sizeof(merge_context_t));
+        ctx->merge_num = i + 1;
+        ctx->mode = MERGE_MODE_HTP;  // Default mode
+        ctx->spans[0].lo = 0;
+        ctx->spans[0].hi = 512;
+        ctx->spans[0].mode = MERGE_MODE_HTP;
+        ctx->span_count = 1;
+        ctx->span = &ctx->spans[0];
+        ctx->timeout_us = MERGE_DEFAULT_TIMEOUT_US;
+        ctx->primary_source_index = -1;
+        ctx->selected_source = -1;
+        ctx->output_active = false;
+        ctx->current_output = 0;
+        ctx->merged_data = ctx->outputs[0].data;
+        ctx->latched_output = MERGE_OUTPUT_NONE;
+        mark_all_dirty(ctx);
+        
+        // Create per-merge mutex
+        ctx->mutex = xSemaphoreCreateMutex();
+        if (!ctx->mutex) {
+            ESP_LOGE(TAG, "Failed to create mutex");
+            destroy_mutexes();
+            pool_destroy();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    // Until subscribed elsewhere, port n outputs merge n
+    for (int i = 0; i < MERGE_MAX_PORTS; i++) {
+        merge_port_t *port = &merge_state.ports[i];
+        memset(port, 0, sizeof(merge_port_t));
+        port->merges[0].merge = i + 1;
+        port->merge_count = 1;
+        port->mode = MERGE_MODE_HTP;
+        atomic_store(&merge_state.merges[i].subscribers, 1);
+        
+        port->mutex = xSemaphoreCreateMutex();
+        if (!port->mutex) {
+            ESP_LOGE(TAG, "Failed to create mutex");
+            destroy_mutexes();
+            pool_destroy();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    merge_state.initialized = true;
+    ESP_LOGI(TAG, "Merge engine initialized successfully (kernel: %s, pool: %d sources)",
+             merge_kernel_name(), merge_state.pool_size);
+             
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_deinit(void)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    ESP_LOGI(TAG, "Deinitializing merge engine...");
+    
+    destroy_mutexes();
+    pool_destroy();
+    
+    merge_state.initialized = false;
+    ESP_LOGI(TAG, "Merge engine deinitialized");
+    
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_config(uint8_t merge, merge_mode_t mode, uint32_t timeout_ms)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || mode > MERGE_MODE_LATEST) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+    
+    ctx->mode = mode;
+    build_spans(ctx);
+    
+    if (timeout_ms > 0) {
+        ctx->timeout_us = timeout_ms * 1000;
+    } else {
+        ctx->timeout_us = MERGE_DEFAULT_TIMEOUT_US;
+    }
+    ctx->next_expiry_us = 0;  // Deadlines follow the new timeout
+    
+    ESP_LOGI(TAG, "Merge %d configured: mode=%d, timeout=%lu ms",
+             merge, mode, ctx->timeout_us / 1000);
+             
+    xSemaphoreGive(ctx->mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_set_channel_modes(uint8_t merge, const channel_mode_range_t *ranges,
+                                         uint8_t count)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || count > CONFIG_MAX_CHANNEL_MODE_RANGES || (count > 0 && !ranges)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int r = 0; r < count; r++) {
+        if (ranges[r].start >= 512 || ranges[r].mode > MERGE_MODE_LATEST) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+    
+    if (count > 0) {
+        memcpy(ctx->mode_ranges, ranges, count * sizeof(channel_mode_range_t));
+    }
+    ctx->mode_range_count = count;
+    build_spans(ctx);
+    
+    ESP_LOGI(TAG, "Merge %d channel modes: %d ranges, %d spans", merge, count, ctx->span_count);
+    
+    xSemaphoreGive(ctx->mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_set_short_frame_policy(uint8_t merge, short_frame_policy_t policy)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || (policy != SHORT_FRAME_HOLD && policy != SHORT_FRAME_ZERO)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Read by the writers on their next push
+    ctx->short_frame_policy = policy;
+    
+    ESP_LOGI(TAG, "Merge %d short frame policy: %s", merge,
+             policy == SHORT_FRAME_ZERO ? "zero" : "hold");
+             
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_set_expiry_callback(merge_expiry_callback_t callback, void *user_data)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    merge_state.expiry_callback = callback;
+    merge_state.expiry_user_data = user_data;
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Add to the subscriber count of each merge in a list, once per merge
+ */
+static void count_subscribers(const merge_subscription_t *merges, uint8_t count, int delta)
+{
+    for (int i = 0; i < count; i++) {
+        bool listed = false;
+        for (int j = 0; j < i; j++) {
+            listed |= (merges[j].merge == merges[i].merge);
+        }
+        if (!listed) {
+            atomic_fetch_add(&merge_state.merges[merges[i].merge - 1].subscribers, delta);
+        }
+    }
+}
+
+esp_err_t merge_engine_subscribe(uint8_t port_num, const merge_subscription_t *merges,
+                                 uint8_t count, merge_mode_t mode)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_port_t *port = get_port(port_num);
+    if (!port || count > MERGE_PORT_MERGES || (count > 0 && !merges) ||
+        mode > MERGE_MODE_LATEST) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!get_merge_context(merges[i].merge) || !is_valid_offset(merges[i].offset)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    // Frames the port still holds are released by address, so the switch
+    // needs no handshake with the output task
+    xSemaphoreTake(port->mutex, portMAX_DELAY);
+    count_subscribers(merges, count, 1);
+    count_subscribers(port->merges, port->merge_count, -1);
+    if (count > 0) {
+        memcpy(port->merges, merges, count * sizeof(merge_subscription_t));
+    }
+    port->merge_count = count;
+    port->mode = mode;
+    xSemaphoreGive(port->mutex);
+    
+    ESP_LOGI(TAG, "Port %d subscribed to %d merges (mode %d)", port_num, count, mode);
+    
+    return ESP_OK;
+}
+
+uint8_t merge_engine_get_port_merges(uint8_t port_num, merge_subscription_t *merges,
+                                     uint8_t max_merges)
+{
+    if (!merge_state.initialized || !merges) {
+        return 0;
+    }
+    
+    merge_port_t *port = get_port(port_num);
+    if (!port) {
+        return 0;
+    }
+    
+    xSemaphoreTake(port->mutex, portMAX_DELAY);
+    uint8_t count = (port->merge_count < max_merges) ? port->merge_count : max_merges;
+    memcpy(merges, port->merges, count * sizeof(merge_subscription_t));
+    xSemaphoreGive(port->mutex);
+    
+    return count;
+}
+
+esp_err_t merge_engine_push_artnet(uint8_t merge, uint16_t universe,
+                                   const uint8_t *data, uint16_t length,
+                                   uint8_t sequence, uint32_t source_ip)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || !data || length == 0 || length > 512) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    source_key_t key = {
+        .source_ip = source_ip,
+        .protocol = SOURCE_PROTOCOL_ARTNET,
+        .universe = universe,
+    };
+    
+    // Name is only formatted when a new source claims a slot
+    char source_name[24] = "";
+    if (!find_source(ctx, &key)) {
+        snprintf(source_name, sizeof(source_name), "ArtNet_%08" PRIX32, source_ip);
     }
     
-    merge_context_t *ctx = get_port_context(port);
+    // Default priority for Art-Net
+    return push_frame(ctx, &key, source_ip, source_name, data, length, sequence,
+                      MERGE_DEFAULT_PRIORITY);
+}
+
+esp_err_t merge_engine_push_sacn(uint8_t merge, uint16_t universe,
+                                 const uint8_t *data, uint8_t sequence,
+                                 uint8_t priority, const char *source_name,
+                                 const uint8_t *cid, uint32_t source_ip)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
     if (!ctx || !data) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
+    source_key_t key;
+    make_sacn_key(&key, universe, cid, source_ip);
     
-    // DMX input always uses source IP 0 and index 0
-    int source_idx = find_or_create_source(ctx, 0, SOURCE_PROTOCOL_DMX_IN);
-    if (source_idx < 0) {
-        ESP_LOGW(TAG, "Port %d: Maximum sources reached", port);
-        xSemaphoreGive(merge_state.mutex);
-        return ESP_ERR_NO_MEM;
+    // Name is only interned when a new source claims a slot
+    char fallback_name[24] = "";
+    if (!source_name) {
+        if (!find_source(ctx, &key)) {
+            snprintf(fallback_name, sizeof(fallback_name), "sACN_%08" PRIX32, source_ip);
+        }
+        source_name = fallback_name;
+    }
+    
+    return push_frame(ctx, &key, source_ip, source_name, data, 512, sequence, priority);
+}
+
+esp_err_t merge_engine_push_sacn_priority(uint8_t merge, uint16_t universe,
+                                          const uint8_t *priorities,
+                                          const char *source_name,
+                                          const uint8_t *cid, uint32_t source_ip)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || !priorities) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    source_key_t key;
+    make_sacn_key(&key, universe, cid, source_ip);
+    
+    // The map may arrive before the first level frame of a source
+    merge_slot_t *slot = find_source(ctx, &key);
+    if (!slot) {
+        char fallback_name[24];
+        if (!source_name) {
+            snprintf(fallback_name, sizeof(fallback_name), "sACN_%08" PRIX32, source_ip);
+            source_name = fallback_name;
+        }
+        slot = claim_source(ctx, &key, source_ip, source_name);
+        if (!slot) {
+            source_overflow(ctx);
+            return ESP_ERR_NO_MEM;
+        }
     }
     
-    // Update source data
-    dmx_source_data_t *source = &ctx->sources[source_idx];
-    memcpy(source->data, data, 512);
-    source->timestamp_us = get_time_us();
-    source->sequence = 0;
-    source->priority = 100;
-    snprintf(source->source_name, sizeof(source->source_name), "DMX_IN_%d", port);
-    source->source_ip = 0;
-    source->protocol = SOURCE_PROTOCOL_DMX_IN;
-    source->is_valid = true;
+    // ~1 Hz, so the map is simply updated under the merge mutex
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
     
-    xSemaphoreGive(merge_state.mutex);
+    memcpy(slot->cold->channel_priority, priorities, 512);
+    slot->cold->channel_priority_time_us = get_time_us();
+    expiry_at(ctx, slot->cold->channel_priority_time_us + ctx->timeout_us);
+    ctx->channel_map_mask |= 1UL << slot->index;
+    ctx->channel_winners_stale = true;
+    mark_all_dirty(ctx);
+    atomic_store(&ctx->dirty, true);
+    
+    xSemaphoreGive(ctx->mutex);
     
     return ESP_OK;
 }
 
+esp_err_t merge_engine_terminate_sacn(uint8_t merge, uint16_t universe, const uint8_t *cid)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_context_t *ctx = get_merge_context(merge);
+    if (!ctx || !cid) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+    
+    // Take frames still in flight first so they cannot revive the source
+    refresh_sources(ctx, get_time_us());
+    
+    bool found = false;
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        merge_slot_t *slot = slot_at(ctx, i);
+        if (!slot || slot->key.protocol != SOURCE_PROTOCOL_SACN ||
+            slot->key.universe != universe ||
+            memcmp(slot->key.cid, cid, MERGE_CID_LENGTH) != 0) {
+            continue;
+        }
+        
+        found = true;
+        slot->terminated = true;
+        
+        // Same as a timeout, without waiting for it
+        if (slot->is_valid) {
+            ctx->stats.source_terminations++;
+            slot->is_valid = false;
+            priority_source_removed(ctx, i);
+            atomic_store(&ctx->dirty, true);
+        }
+        if (ctx->channel_map_mask & (1UL << i)) {
+            ctx->channel_map_mask &= ~(1UL << i);
+            ctx->channel_winners_stale = true;
+        }
+    }
+    
+    xSemaphoreGive(ctx->mutex);
+    
+    if (found) {
+        ESP_LOGI(TAG, "Merge %d: sACN source on universe %d terminated its stream",
+                 ctx->merge_num, universe);
+    }
+    
+    return found ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t merge_engine_push_dmx_in(uint8_t port, const uint8_t *data)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(port_ctx->mutex, portMAX_DELAY);
+    merge_context_t *ctx = port_ctx->merge_count ?
+                           get_merge_context(port_ctx->merges[0].merge) : NULL;
+    xSemaphoreGive(port_ctx->mutex);
+    if (!ctx) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // DMX input always uses source IP 0
+    source_key_t key = {
+        .source_ip = 0,
+        .protocol = SOURCE_PROTOCOL_DMX_IN,
+    };
+    
+    // Name is only formatted when the input claims a slot
+    char source_name[16] = "";
+    if (!find_source(ctx, &key)) {
+        snprintf(source_name, sizeof(source_name), "DMX_IN_%d", port);
+    }
+    
+    return push_frame(ctx, &key, 0, source_name, data, 512, 0, MERGE_DEFAULT_PRIORITY);
+}
+
+/**
+ * @brief Bring the port output up to date (merge mutex held)
+ * 
+ * @return Buffer holding the frame to output, or NULL if there is none
+ */
+static output_buffer_t* update_output(merge_context_t *ctx)
+{
+    // Sync mode: new data waits in the source slots for the next latch
+    if (is_sync_active(ctx)) {
+        if (!ctx->latched_active) {
+            return NULL;
+        }
+        return &ctx->outputs[ctx->latched_output];
+    }
+    
+    // Take fresh frames and cleanup timeout sources (marks the port dirty if one expired)
+    uint64_t now = get_time_us();
+    refresh_sources(ctx, now);
+    
+    // Only re-merge when a push or timeout changed the inputs since the last frame
+    if (atomic_exchange(&ctx->dirty, false)) {
+        perform_merge(ctx, now);
+    } else {
+        ctx->stats.clean_frames++;
+    }
+    
+    return ctx->output_active ? &ctx->outputs[ctx->current_output] : NULL;
+}
+
+/**
+ * @brief Take the current frame of each merge a port reads (port mutex held)
+ * 
+ * Each frame is held by reference, so the merges can move on while the port
+ * composes; drop them with port_drop_inputs.
+ * 
+ * @return Number of merges with a frame to output
+ */
+static int port_take_inputs(const merge_port_t *port, port_input_t *inputs)
+{
+    int count = 0;
+    
+    for (int i = 0; i < port->merge_count; i++) {
+        merge_context_t *ctx = get_merge_context(port->merges[i].merge);
+        
+        xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+        output_buffer_t *output = update_output(ctx);
+        if (output) {
+            atomic_fetch_add(&output->refs, 1);
+            ctx->stats.output_copies++;
+            inputs[count].output = output;
+            inputs[count].offset = port->merges[i].offset;
+            inputs[count].merge_time_us = ctx->last_merge_time_us;
+            count++;
+        }
+        xSemaphoreGive(ctx->mutex);
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Release the frames taken by port_take_inputs
+ */
+static void port_drop_inputs(port_input_t *inputs, int count)
+{
+    for (int i = 0; i < count; i++) {
+        atomic_fetch_sub(&inputs[i].output->refs, 1);
+    }
+}
+
+/**
+ * @brief Compose a port's frame from its merges' frames
+ * 
+ * Merge channel n lands on port channel n + offset. HTP keeps the highest
+ * and LTP the lowest value where frames overlap; the other modes lay the
+ * frames over each other, the preferred one on top: the merge that ran last
+ * for LAST and LATEST, the first subscribed for BACKUP and DISABLE.
+ * Channels no frame reaches are 0.
+ */
+static void port_compose(const merge_port_t *port, port_input_t *inputs, int count,
+                         uint8_t *data)
+{
+    uint32_t covered[CHANNEL_MAP_WORDS] = {0};
+    
+    // Least preferred first, so the preferred frames end up on top
+    if (port->mode == MERGE_MODE_LAST || port->mode == MERGE_MODE_LATEST) {
+        for (int a = 1; a < count; a++) {
+            port_input_t input = inputs[a];
+            int b = a;
+            while (b > 0 && inputs[b - 1].merge_time_us > input.merge_time_us) {
+                inputs[b] = inputs[b - 1];
+                b--;
+            }
+            inputs[b] = input;
+        }
+    } else if (port->mode == MERGE_MODE_BACKUP || port->mode == MERGE_MODE_DISABLE) {
+        for (int a = 0, b = count - 1; a < b; a++, b--) {
+            port_input_t input = inputs[a];
+            inputs[a] = inputs[b];
+            inputs[b] = input;
+        }
+    }
+    
+    memset(data, 0, 512);
+    for (int i = 0; i < count; i++) {
+        // Port channels [lo, hi) show merge channels from lo - offset on
+        int16_t offset = inputs[i].offset;
+        uint16_t lo = (offset > 0) ? offset : 0;
+        uint16_t hi = (offset < 0) ? 512 + offset : 512;
+        const uint8_t *src = inputs[i].output->data + (lo - offset);
+        
+        if (port->mode == MERGE_MODE_HTP) {
+            merge_kernel_max(data + lo, src, hi - lo);
+        } else if (port->mode == MERGE_MODE_LTP) {
+            for (int ch = lo; ch < hi; ch++) {
+                uint32_t bit = 1UL << (ch & 31);
+                uint8_t value = src[ch - lo];
+                if (!(covered[ch >> 5] & bit) || value < data[ch]) {
+                    data[ch] = value;
+                }
+                covered[ch >> 5] |= bit;
+            }
+        } else {
+            memcpy(data + lo, src, hi - lo);
+        }
+    }
+}
+
+/**
+ * @brief Whether a port borrows its one merge's frames as they are
+ */
+static inline bool port_reads_through(const merge_port_t *port)
+{
+    return port->merge_count == 1 && port->merges[0].offset == 0;
+}
+
 esp_err_t merge_engine_get_output(uint8_t port, uint8_t *data)
 {
     if (!merge_state.initialized) {
-        return ESP_ERR_INVALID_STATE;
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    port_input_t inputs[MERGE_PORT_MERGES];
+    
+    xSemaphoreTake(port_ctx->mutex, portMAX_DELAY);
+    int count = port_take_inputs(port_ctx, inputs);
+    if (port_reads_through(port_ctx) && count == 1) {
+        memcpy(data, inputs[0].output->data, 512);
+    } else {
+        // All 0 if no merge has active sources
+        port_compose(port_ctx, inputs, count, data);
+    }
+    port_drop_inputs(inputs, count);
+    xSemaphoreGive(port_ctx->mutex);
+    
+    return count ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t merge_engine_acquire_output(uint8_t port, const uint8_t **data)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *data = NULL;
+    xSemaphoreTake(port_ctx->mutex, portMAX_DELAY);
+    
+    if (port_reads_through(port_ctx)) {
+        // Lend the merged frame itself
+        merge_context_t *ctx = get_merge_context(port_ctx->merges[0].merge);
+        xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+        output_buffer_t *output = update_output(ctx);
+        if (output) {
+            atomic_fetch_add(&output->refs, 1);
+            ctx->stats.output_refs++;
+            *data = output->data;
+        }
+        xSemaphoreGive(ctx->mutex);
+    } else {
+        port_input_t inputs[MERGE_PORT_MERGES];
+        int count = port_take_inputs(port_ctx, inputs);
+        
+        // Refs only grow under the port mutex, so a free frame stays free
+        for (int b = 0; b < MERGE_PORT_FRAMES && count > 0 && !*data; b++) {
+            output_buffer_t *frame = &port_ctx->frames[b];
+            if (atomic_load(&frame->refs) == 0) {
+                port_compose(port_ctx, inputs, count, frame->data);
+                atomic_fetch_add(&frame->refs, 1);
+                *data = frame->data;
+            }
+        }
+        port_drop_inputs(inputs, count);
+        
+        if (count > 0 && !*data) {
+            // Unreachable while every acquire is paired with a release
+            ESP_LOGE(TAG, "Port %d: no free frame", port);
+        }
+    }
+    
+    xSemaphoreGive(port_ctx->mutex);
+    
+    return *data ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t merge_engine_release_output(const uint8_t *data)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // Found by address, so a port subscribed elsewhere since the acquire releases correctly
+    output_buffer_t *output = find_output(data);
+    if (!output || atomic_load(&output->refs) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    atomic_fetch_sub(&output->refs, 1);
+    
+    return ESP_OK;
+}
+
+esp_err_t merge_engine_sync_latch(const uint8_t *merges, uint8_t count, uint32_t timeout_ms)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!merges || count == 0 || timeout_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        if (!get_merge_context(merges[i])) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    // Each merge is merged once and its output latched for every port
+    // subscribed to it; the ports pick it up on their next frame
+    uint32_t now_ms = (uint32_t)(get_time_us() / 1000);
+    for (int i = 0; i < count; i++) {
+        merge_context_t *ctx = get_merge_context(merges[i]);
+        if (atomic_load(&ctx->subscribers) == 0) {
+            continue;
+        }
+        
+        xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+        
+        uint64_t now = get_time_us();
+        refresh_sources(ctx, now);
+        if (atomic_exchange(&ctx->dirty, false)) {
+            perform_merge(ctx, now);
+        } else {
+            ctx->stats.clean_frames++;
+        }
+        
+        // The latch holds the merged frame itself; the next merge moves on
+        latch_release(ctx);
+        ctx->latched_output = ctx->current_output;
+        atomic_fetch_add(&ctx->outputs[ctx->current_output].refs, 1);
+        ctx->latched_active = ctx->output_active;
+        ctx->stats.sync_latches++;
+        
+        xSemaphoreGive(ctx->mutex);
+        
+        atomic_store(&ctx->sync_timeout_ms, timeout_ms);
+        atomic_store(&ctx->sync_time_ms, now_ms);
+        if (!atomic_exchange(&ctx->sync_mode, true)) {
+            atomic_fetch_or(&merge_state.sync_mask, 1u << (merges[i] - 1));
+            ESP_LOGI(TAG, "Merge %d: sync received, output now latched on sync", merges[i]);
+        }
+    }
+    
+    return ESP_OK;
+}
+
+bool merge_engine_is_sync_active(void)
+{
+    if (!merge_state.initialized) {
+        return false;
     }
     
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx || !data) {
-        return ESP_ERR_INVALID_ARG;
+    // Set on a merge's first latch, cleared once its port reads find it timed out
+    return atomic_load(&merge_state.sync_mask) != 0;
+}
+
+/**
+ * @brief Copy a port's merges, each merge once (port mutex taken here)
+ * 
+ * @return Number of merges written
+ */
+static int port_distinct_merges(merge_port_t *port, merge_context_t **merges)
+{
+    int count = 0;
+    
+    xSemaphoreTake(port->mutex, portMAX_DELAY);
+    for (int i = 0; i < port->merge_count; i++) {
+        merge_context_t *ctx = get_merge_context(port->merges[i].merge);
+        bool listed = false;
+        for (int j = 0; j < count; j++) {
+            listed |= (merges[j] == ctx);
+        }
+        if (!listed) {
+            merges[count++] = ctx;
+        }
     }
+    xSemaphoreGive(port->mutex);
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    
-    // Cleanup timeout sources
-    cleanup_timeout_sources(ctx);
-    
-    // Perform merge
-    perform_merge(ctx);
-    
-    // Copy output data
-    if (ctx->output_active) {
-        memcpy(data, ctx->merged_data, 512);
-        xSemaphoreGive(merge_state.mutex);
-        return ESP_OK;
-    } else {
-        // No active sources - return blackout
-        memset(data, 0, 512);
-        xSemaphoreGive(merge_state.mutex);
-        return ESP_ERR_TIMEOUT;
-    }
+    return count;
 }
 
 bool merge_engine_is_output_active(uint8_t port)
@@ -415,49 +2124,82 @@ bool merge_engine_is_output_active(uint8_t port)
         return false;
     }
     
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx) {
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx) {
         return false;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    cleanup_timeout_sources(ctx);
-    uint8_t active = count_active_sources(ctx);
-    xSemaphoreGive(merge_state.mutex);
+    merge_context_t *merges[MERGE_PORT_MERGES];
+    int count = port_distinct_merges(port_ctx, merges);
+    uint8_t active = 0;
+    
+    for (int i = 0; i < count && !active; i++) {
+        merge_context_t *ctx = merges[i];
+        xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+        refresh_sources(ctx, get_time_us());
+        active = count_active_sources(ctx);
+        xSemaphoreGive(ctx->mutex);
+    }
     
     return active > 0;
 }
 
+/**
+ * @brief Drop all sources of a merge and clear its output
+ */
+static void merge_blackout(merge_context_t *ctx)
+{
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+    
+    // Invalidate all sources (a later push brings a source back)
+    refresh_sources(ctx, get_time_us());
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (slot_at(ctx, i)) {
+            slot_at(ctx, i)->is_valid = false;
+        }
+    }
+    ctx->priority_mask = 0;
+    ctx->top_priority = 0;
+    ctx->channel_map_mask = 0;
+    ctx->channel_winners_stale = true;
+    
+    // Clear output (frames still held by an output stay as they are)
+    latch_release(ctx);
+    output_prepare(ctx, 0, 512);
+    memset(ctx->merged_data, 0, 512);
+    ctx->output_active = false;
+    ctx->selected_source = -1;
+    mark_all_dirty(ctx);
+    atomic_store(&ctx->dirty, false);
+    
+    ESP_LOGI(TAG, "Merge %d blackout", ctx->merge_num);
+    
+    xSemaphoreGive(ctx->mutex);
+}
+
 esp_err_t merge_engine_blackout(uint8_t port)
 {
     if (!merge_state.initialized) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx) {
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    
-    // Invalidate all sources
-    for (int i = 0; i < ctx->source_count; i++) {
-        ctx->sources[i].is_valid = false;
+    merge_context_t *merges[MERGE_PORT_MERGES];
+    int count = port_distinct_merges(port_ctx, merges);
+    for (int i = 0; i < count; i++) {
+        merge_blackout(merges[i]);
     }
     
-    // Clear output
-    memset(ctx->merged_data, 0, 512);
-    ctx->output_active = false;
-    
     ESP_LOGI(TAG, "Port %d blackout", port);
     
-    xSemaphoreGive(merge_state.mutex);
-    
     return ESP_OK;
 }
 
-uint8_t merge_engine_get_active_sources(uint8_t port, 
+uint8_t merge_engine_get_active_sources(uint8_t port,
                                        dmx_source_data_t *sources,
                                        uint8_t max_sources)
 {
@@ -465,65 +2207,118 @@ uint8_t merge_engine_get_active_sources(uint8_t port,
         return 0;
     }
     
-    merge_context_t *ctx = get_port_context(port);
-    if (!ctx) {
+    merge_port_t *port_ctx = get_port(port);
+    if (!port_ctx) {
         return 0;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
-    
-    cleanup_timeout_sources(ctx);
-    
+    merge_context_t *merges[MERGE_PORT_MERGES];
+    int merge_count = port_distinct_merges(port_ctx, merges);
     uint8_t count = 0;
-    for (int i = 0; i < ctx->source_count && count < max_sources; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            memcpy(&sources[count], &ctx->sources[i], sizeof(dmx_source_data_t));
-            count++;
+    
+    for (int m = 0; m < merge_count && count < max_sources; m++) {
+        merge_context_t *ctx = merges[m];
+        xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+        
+        refresh_sources(ctx, get_time_us());
+        
+        for (int i = 0; i < MERGE_MAX_SOURCES && count < max_sources; i++) {
+            const merge_slot_t *slot = slot_at(ctx, i);
+            if (slot && slot->is_valid) {
+                const merge_frame_t *frame = slot_front(slot);
+                dmx_source_data_t *out = &sources[count];
+                memcpy(out->data, frame->data, 512);
+                out->timestamp_us = frame->timestamp_us;
+                out->sequence = frame->sequence;
+                out->priority = frame->priority;
+                out->name_id = slot->name_id;
+                out->source_ip = slot->source_ip;
+                out->protocol = slot->key.protocol;
+                out->universe = slot->key.universe;
+                out->is_valid = true;
+                count++;
+            }
         }
+        
+        xSemaphoreGive(ctx->mutex);
     }
     
-    xSemaphoreGive(merge_state.mutex);
-    
     return count;
 }
 
-esp_err_t merge_engine_get_stats(uint8_t port, merge_stats_t *stats)
+esp_err_t merge_engine_get_source_name(uint8_t name_id, char *name, size_t max_length)
+{
+    if (!merge_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!name || max_length == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (name_id >= merge_state.pool_size) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    xSemaphoreTake(merge_state.names_mutex, portMAX_DELAY);
+    
+    const name_entry_t *entry = &merge_state.names[name_id];
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    if (entry->refs) {
+        strncpy(name, entry->name, max_length - 1);
+        name[max_length - 1] = '\0';
+        ret = ESP_OK;
+    }
+    
+    xSemaphoreGive(merge_state.names_mutex);
+    
+    return ret;
+}
+
+esp_err_t merge_engine_get_stats(uint8_t merge, merge_stats_t *stats)
 {
     if (!merge_state.initialized) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    merge_context_t *ctx = get_port_context(port);
+    merge_context_t *ctx = get_merge_context(merge);
     if (!ctx || !stats) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
     
     memcpy(stats, &ctx->stats, sizeof(merge_stats_t));
+    stats->slot_copies = atomic_load(&ctx->slot_copies);
+    stats->source_overflows = atomic_load(&ctx->source_overflows);
+    stats->pool_free = __builtin_popcount(merge_state.pool_free_mask);
     stats->active_sources = count_active_sources(ctx);
+    stats->active_priority = ctx->top_priority;
+    stats->subscribers = atomic_load(&ctx->subscribers);
     
-    xSemaphoreGive(merge_state.mutex);
+    xSemaphoreGive(ctx->mutex);
     
     return ESP_OK;
 }
 
-esp_err_t merge_engine_reset_stats(uint8_t port)
+esp_err_t merge_engine_reset_stats(uint8_t merge)
 {
     if (!merge_state.initialized) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    merge_context_t *ctx = get_port_context(port);
+    merge_context_t *ctx = get_merge_context(merge);
     if (!ctx) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    xSemaphoreTake(merge_state.mutex, portMAX_DELAY);
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
     memset(&ctx->stats, 0, sizeof(merge_stats_t));
-    xSemaphoreGive(merge_state.mutex);
+    atomic_store(&ctx->slot_copies, 0);
+    atomic_store(&ctx->source_overflows, 0);
+    xSemaphoreGive(ctx->mutex);
     
-    ESP_LOGI(TAG, "Port %d statistics reset", port);
+    ESP_LOGI(TAG, "Merge %d statistics reset", merge);
     
     return ESP_OK;
 }
@@ -532,174 +2327,573 @@ esp_err_t merge_engine_reset_stats(uint8_t port)
 // Internal Merge Functions
 // ============================================================================
 
+/**
+ * @brief Merge channels [lo, hi) of the current span with its mode
+ */
+static uint16_t merge_span(merge_context_t *ctx, uint16_t lo, uint16_t hi,
+                           const uint32_t *changed)
+{
+    uint16_t recomputed;
+    
+    // Per-address priority in use - arbitrate channel by channel
+    if (ctx->channel_map_mask) {
+        recomputed = merge_per_channel(ctx, lo, hi);
+        ctx->stats.channel_priority_merges++;
+    } else {
+        switch (ctx->span->mode) {
+            case MERGE_MODE_HTP:
+                recomputed = merge_htp(ctx, lo, hi);
+                ctx->stats.htp_merges++;
+                break;
+                
+            case MERGE_MODE_LTP:
+                recomputed = merge_ltp(ctx, lo, hi);
+                ctx->stats.ltp_merges++;
+                break;
+                
+            case MERGE_MODE_LAST:
+                recomputed = merge_last(ctx, lo, hi);
+                ctx->stats.last_merges++;
+                break;
+                
+            case MERGE_MODE_BACKUP:
+                recomputed = merge_backup(ctx, lo, hi);
+                break;
+                
+            case MERGE_MODE_LATEST:
+                // Driven by the changed channels, not the dirty span
+                recomputed = merge_latest(ctx, changed, ctx->span->lo, ctx->span->hi);
+                ctx->stats.latest_merges++;
+                break;
+                
+            case MERGE_MODE_DISABLE:
+            default:
+                recomputed = merge_disable(ctx, lo, hi);
+                break;
+        }
+    }
+    
+    return recomputed;
+}
+
+/**
+ * @brief Whether a span must be visited on every merge, dirty or not
+ * 
+ * LAST, BACKUP and DISABLE copy one selected source that may change between
+ * merges; LATEST follows its changed channels.
+ */
+static inline bool span_always_merged(merge_mode_t mode)
+{
+    return mode != MERGE_MODE_HTP && mode != MERGE_MODE_LTP;
+}
+
 /**
  * @brief Perform merge based on configured mode
+ * 
+ * The merge functions only see sources in priority_mask, i.e. the valid
+ * sources at the highest active priority, and only recompute the dirty
+ * channel span. With a channel-mode map each span is merged on its own.
+ * 
+ * @param now Time snapshot taken for this output frame
  */
-static void perform_merge(merge_context_t *ctx)
+static void perform_merge(merge_context_t *ctx, uint64_t now)
 {
+    uint16_t lo = ctx->dirty_lo;
+    uint16_t hi = ctx->dirty_hi;
+    uint16_t recomputed = 0;
+    uint32_t changed[CHANNEL_MAP_WORDS];
+    
+    // LATEST: stamp the queued changes first, 0xDD arbitration uses them too
+    if (ctx->latest_in_use) {
+        latest_apply_changes(ctx, changed);
+    }
+    
+    if (lo >= hi) {
+        lo = hi = 0;
+    }
+    ctx->dirty_lo = 512;
+    ctx->dirty_hi = 0;
+    
+    // Every kernel rewrites at least [lo, hi), except LATEST: it only writes
+    // the channels that changed, so a held frame is carried over whole
+    if (ctx->latest_in_use) {
+        output_prepare(ctx, 0, 0);
+    } else {
+        output_prepare(ctx, lo, hi);
+    }
+    
     ctx->stats.total_merges++;
     ctx->stats.active_sources = count_active_sources(ctx);
     
-    switch (ctx->mode) {
-        case MERGE_MODE_HTP:
-            merge_htp(ctx);
-            ctx->stats.htp_merges++;
-            break;
-            
-        case MERGE_MODE_LTP:
-            merge_ltp(ctx);
-            ctx->stats.ltp_merges++;
-            break;
-            
-        case MERGE_MODE_LAST:
-            merge_last(ctx);
-            ctx->stats.last_merges++;
-            break;
-            
-        case MERGE_MODE_BACKUP:
-            merge_backup(ctx);
-            break;
+    if (ctx->channel_map_mask && ctx->channel_winners_stale) {
+        update_channel_winners(ctx);
+    }
+    
+    if (ctx->span_count == 1) {
+        ctx->span = &ctx->spans[0];
+        recomputed = merge_span(ctx, lo, hi, changed);
+    } else {
+        // Output is active if any span has a source (HTP/LTP, nothing dirty: any merged source)
+        bool active = false;
+        bool merged = false;
+        for (int s = 0; s < ctx->span_count; s++) {
+            ctx->span = &ctx->spans[s];
+            uint16_t a = (lo > ctx->span->lo) ? lo : ctx->span->lo;
+            uint16_t b = (hi < ctx->span->hi) ? hi : ctx->span->hi;
             
-        case MERGE_MODE_DISABLE:
-        default:
-            merge_disable(ctx);
-            break;
+            if (span_always_merged(ctx->span->mode)) {
+                a = ctx->span->lo;
+                b = ctx->span->hi;
+            }
+            if (a < b) {
+                recomputed += merge_span(ctx, a, b, changed);
+                active |= ctx->output_active;
+                merged = true;
+            }
+        }
+        ctx->output_active = merged ? active : (ctx->priority_mask != 0);
+        ctx->stats.mode_map_merges++;
     }
     
-    ctx->last_merge_time_us = get_time_us();
+    ctx->stats.channels_recomputed = recomputed;
+    ctx->stats.channels_recomputed_total += recomputed;
+    ctx->last_merge_time_us = now;
 }
 
 /**
  * @brief HTP (Highest Takes Precedence) merge
  * Takes the maximum value for each channel across all active sources
  */
-static void merge_htp(merge_context_t *ctx)
+static uint16_t merge_htp(merge_context_t *ctx, uint16_t lo, uint16_t hi)
 {
-    memset(ctx->merged_data, 0, 512);
-    ctx->output_active = false;
-    
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            ctx->output_active = true;
-            
-            for (int ch = 0; ch < 512; ch++) {
-                if (ctx->sources[i].data[ch] > ctx->merged_data[ch]) {
-                    ctx->merged_data[ch] = ctx->sources[i].data[ch];
-                }
-            }
+    memset(ctx->merged_data + lo, 0, hi - lo);
+    ctx->output_active = (ctx->priority_mask != 0);
+    ctx->selected_source = -1;
+    
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (ctx->priority_mask & (1UL << i)) {
+            const uint8_t *src = slot_front(slot_at(ctx, i))->data;
+            merge_kernel_max(ctx->merged_data + lo, src + lo, hi - lo);
         }
     }
+    
+    return hi - lo;
 }
 
 /**
  * @brief LTP (Lowest Takes Precedence) merge
  * Takes the minimum value for each channel across all active sources
  */
-static void merge_ltp(merge_context_t *ctx)
+static uint16_t merge_ltp(merge_context_t *ctx, uint16_t lo, uint16_t hi)
 {
-    memset(ctx->merged_data, 255, 512);
-    ctx->output_active = false;
-    
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            ctx->output_active = true;
-            
-            for (int ch = 0; ch < 512; ch++) {
-                if (ctx->sources[i].data[ch] < ctx->merged_data[ch]) {
-                    ctx->merged_data[ch] = ctx->sources[i].data[ch];
-                }
-            }
+    memset(ctx->merged_data + lo, 255, hi - lo);
+    ctx->output_active = (ctx->priority_mask != 0);
+    ctx->selected_source = -1;
+    
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (ctx->priority_mask & (1UL << i)) {
+            const uint8_t *src = slot_front(slot_at(ctx, i))->data;
+            merge_kernel_min(ctx->merged_data + lo, src + lo, hi - lo);
         }
     }
     
     // If no sources, output 0 instead of 255
     if (!ctx->output_active) {
-        memset(ctx->merged_data, 0, 512);
+        memset(ctx->merged_data + lo, 0, hi - lo);
+    }
+    
+    return hi - lo;
+}
+
+/**
+ * @brief Copy one source to the output (LAST/BACKUP/DISABLE)
+ * 
+ * Only the dirty channels are copied while the same source stays selected;
+ * a switch to another source copies the whole span.
+ */
+static uint16_t copy_selected(merge_context_t *ctx, int index, uint16_t lo, uint16_t hi)
+{
+    if (index != ctx->selected_source) {
+        ctx->selected_source = index;
+        lo = ctx->span->lo;
+        hi = ctx->span->hi;
     }
+    
+    if (index < 0) {
+        memset(ctx->merged_data + lo, 0, hi - lo);
+        ctx->output_active = false;
+        return hi - lo;
+    }
+    
+    memcpy(ctx->merged_data + lo, slot_front(slot_at(ctx, index))->data + lo, hi - lo);
+    ctx->output_active = true;
+    
+    return hi - lo;
 }
 
 /**
  * @brief LAST (Latest Takes Precedence) merge
  * Uses the entire frame from the most recently updated source
  */
-static void merge_last(merge_context_t *ctx)
+static uint16_t merge_last(merge_context_t *ctx, uint16_t lo, uint16_t hi)
 {
     uint64_t latest_time = 0;
-    dmx_source_data_t *latest_source = NULL;
+    int latest = -1;
     
     // Find the most recent source
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            if (ctx->sources[i].timestamp_us > latest_time) {
-                latest_time = ctx->sources[i].timestamp_us;
-                latest_source = &ctx->sources[i];
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (ctx->priority_mask & (1UL << i)) {
+            const merge_frame_t *frame = slot_front(slot_at(ctx, i));
+            if (frame->timestamp_us > latest_time) {
+                latest_time = frame->timestamp_us;
+                latest = i;
             }
         }
     }
     
-    if (latest_source) {
-        memcpy(ctx->merged_data, latest_source->data, 512);
-        ctx->output_active = true;
-    } else {
-        memset(ctx->merged_data, 0, 512);
-        ctx->output_active = false;
-    }
+    return copy_selected(ctx, latest, lo, hi);
 }
 
 /**
  * @brief BACKUP merge
  * Uses primary source, switches to backup on timeout
  */
-static void merge_backup(merge_context_t *ctx)
+static uint16_t merge_backup(merge_context_t *ctx, uint16_t lo, uint16_t hi)
 {
     // If primary source index is valid and not timeout, use it
-    if (ctx->primary_source_index >= 0 && 
-        ctx->primary_source_index < ctx->source_count) {
+    if (ctx->primary_source_index >= 0 &&
+        ctx->primary_source_index < MERGE_MAX_SOURCES) {
         
-        dmx_source_data_t *primary = &ctx->sources[ctx->primary_source_index];
-        
-        if (!is_source_timeout(primary, ctx->timeout_us)) {
-            memcpy(ctx->merged_data, primary->data, 512);
-            ctx->output_active = true;
-            return;
+        if (ctx->priority_mask & (1UL << ctx->primary_source_index)) {
+            return copy_selected(ctx, ctx->primary_source_index, lo, hi);
         }
     }
     
     // Primary timeout or not set - find any active source as backup
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            memcpy(ctx->merged_data, ctx->sources[i].data, 512);
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (ctx->priority_mask & (1UL << i)) {
             ctx->primary_source_index = i;  // This becomes new primary
-            ctx->output_active = true;
             ctx->stats.backup_switches++;
-            ESP_LOGI(TAG, "Port %d: Switched to backup source %d", 
-                     ctx->port_num, i);
-            return;
+            ESP_LOGI(TAG, "Merge %d: Switched to backup source %d",
+                     ctx->merge_num, i);
+            return copy_selected(ctx, i, lo, hi);
         }
     }
     
     // No sources available
-    memset(ctx->merged_data, 0, 512);
-    ctx->output_active = false;
     ctx->primary_source_index = -1;
+    return copy_selected(ctx, -1, lo, hi);
 }
 
 /**
  * @brief DISABLE merge
  * No merging - uses first active source only
  */
-static void merge_disable(merge_context_t *ctx)
+static uint16_t merge_disable(merge_context_t *ctx, uint16_t lo, uint16_t hi)
 {
     // Find first active source
-    for (int i = 0; i < ctx->source_count; i++) {
-        if (!is_source_timeout(&ctx->sources[i], ctx->timeout_us)) {
-            memcpy(ctx->merged_data, ctx->sources[i].data, 512);
-            ctx->output_active = true;
-            return;
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (ctx->priority_mask & (1UL << i)) {
+            return copy_selected(ctx, i, lo, hi);
         }
     }
     
     // No active source
-    memset(ctx->merged_data, 0, 512);
-    ctx->output_active = false;
+    return copy_selected(ctx, -1, lo, hi);
+}
+
+/**
+ * @brief Order sources in mask by preference for LAST/BACKUP/DISABLE
+ * 
+ * LAST = newest first, BACKUP = primary first, DISABLE = slot order.
+ * 
+ * @return Number of sources written to order
+ */
+static int build_source_order(const merge_context_t *ctx, uint32_t mask,
+                              int order[MERGE_MAX_SOURCES])
+{
+    int count = 0;
+    
+    if (ctx->span->mode == MERGE_MODE_BACKUP && ctx->primary_source_index >= 0 &&
+        (mask & (1UL << ctx->primary_source_index))) {
+        order[count++] = ctx->primary_source_index;
+    }
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if ((mask & (1UL << i)) && !(count > 0 && order[0] == i)) {
+            order[count++] = i;
+        }
+    }
+    if (ctx->span->mode == MERGE_MODE_LAST) {
+        for (int a = 1; a < count; a++) {
+            int idx = order[a];
+            uint64_t t = slot_front(slot_at(ctx, idx))->timestamp_us;
+            int b = a;
+            while (b > 0 && slot_front(slot_at(ctx, order[b - 1]))->timestamp_us < t) {
+                order[b] = order[b - 1];
+                b--;
+            }
+            order[b] = idx;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Whether source a changed a channel more recently than source b
+ * 
+ * Compares stamp ages, so tick wrap does not matter; equal stamps go to
+ * the source with the newer frame.
+ */
+static bool latest_is_newer(const merge_context_t *ctx, int a, int b, int ch)
+{
+    uint16_t age_a = ctx->latest_tick - slot_at(ctx, a)->change_tick[ch];
+    uint16_t age_b = ctx->latest_tick - slot_at(ctx, b)->change_tick[ch];
+    if (age_a != age_b) {
+        return age_a < age_b;
+    }
+    return slot_front(slot_at(ctx, a))->timestamp_us >
+           slot_front(slot_at(ctx, b))->timestamp_us;
+}
+
+/**
+ * @brief Pull every stamp older than LATEST_AGE_LIMIT up to it
+ */
+static void latest_age_ticks(merge_context_t *ctx)
+{
+    uint16_t oldest = ctx->latest_tick - LATEST_AGE_LIMIT;
+    
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (!slot_at(ctx, i)) {
+            continue;
+        }
+        uint16_t *ticks = slot_at(ctx, i)->change_tick;
+        for (int ch = 0; ch < 512; ch++) {
+            if ((uint16_t)(ctx->latest_tick - ticks[ch]) > LATEST_AGE_LIMIT) {
+                ticks[ch] = oldest;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Stamp the queued changes and hand the channels to their sources
+ * 
+ * Sources are taken oldest frame first, so when two changed a channel since
+ * the last merge the newer one ends up owning it. Cost is proportional to
+ * the number of changed channels.
+ * 
+ * @param changed Set to the channels whose output may have changed (all of
+ *                them after the source set changed)
+ */
+static void latest_apply_changes(merge_context_t *ctx, uint32_t *changed)
+{
+    memset(changed, 0, CHANNEL_MAP_WORDS * sizeof(uint32_t));
+    
+    uint32_t pending = ctx->latest_pending_mask;
+    ctx->latest_pending_mask = 0;
+    
+    while (pending) {
+        int index = -1;
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            if ((pending & (1UL << i)) &&
+                (index < 0 || slot_front(slot_at(ctx, i))->timestamp_us <
+                              slot_front(slot_at(ctx, index))->timestamp_us)) {
+                index = i;
+            }
+        }
+        pending &= ~(1UL << index);
+        
+        // One tick per source, so the stamps keep the order of the changes
+        ctx->latest_tick++;
+        if ((ctx->latest_tick & (LATEST_AGE_LIMIT - 1)) == 0) {
+            latest_age_ticks(ctx);
+        }
+        
+        // Only merged sources take channels; the others keep their stamps
+        merge_slot_t *slot = slot_at(ctx, index);
+        bool merged = (ctx->priority_mask & (1UL << index)) != 0;
+        
+        for (int w = 0; w < CHANNEL_MAP_WORDS; w++) {
+            uint32_t bits = slot->pending_changes[w];
+            if (!bits) {
+                continue;
+            }
+            slot->pending_changes[w] = 0;
+            if (merged) {
+                changed[w] |= bits;
+            }
+            
+            while (bits) {
+                int ch = (w << 5) + __builtin_ctz(bits);
+                slot->change_tick[ch] = ctx->latest_tick;
+                if (merged) {
+                    ctx->channel_owner[ch] = index;
+                }
+                bits &= bits - 1;
+            }
+        }
+    }
+    
+    // The source set changed: every channel may have a new owner
+    if (ctx->owners_stale) {
+        latest_rebuild_owners(ctx);
+        memset(changed, 0xFF, CHANNEL_MAP_WORDS * sizeof(uint32_t));
+    }
+}
+
+/**
+ * @brief Reassign every channel to the merged source that changed it last
+ */
+static void latest_rebuild_owners(merge_context_t *ctx)
+{
+    for (int ch = 0; ch < 512; ch++) {
+        int owner = LATEST_OWNER_NONE;
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            if ((ctx->priority_mask & (1UL << i)) &&
+                (owner == LATEST_OWNER_NONE || latest_is_newer(ctx, i, owner, ch))) {
+                owner = i;
+            }
+        }
+        ctx->channel_owner[ch] = owner;
+    }
+    
+    ctx->owners_stale = false;
+    ctx->stats.owner_rebuilds++;
+}
+
+/**
+ * @brief LATEST (per-channel Latest Takes Precedence) merge
+ * 
+ * Each channel shows its owner's value. Only the changed channels in
+ * [lo, hi) are rewritten.
+ */
+static uint16_t merge_latest(merge_context_t *ctx, const uint32_t *changed,
+                             uint16_t lo, uint16_t hi)
+{
+    ctx->output_active = (ctx->priority_mask != 0);
+    ctx->selected_source = -1;
+    
+    if (lo >= hi) {
+        return 0;
+    }
+    
+    uint16_t count = 0;
+    int last = (hi - 1) >> 5;
+    for (int w = lo >> 5; w <= last; w++) {
+        uint32_t bits = changed[w];
+        if (w == (lo >> 5)) {
+            bits &= ~0UL << (lo & 31);
+        }
+        if (w == last && (hi & 31)) {
+            bits &= (1UL << (hi & 31)) - 1;
+        }
+        while (bits) {
+            int ch = (w << 5) + __builtin_ctz(bits);
+            int owner = ctx->channel_owner[ch];
+            ctx->merged_data[ch] = (owner != LATEST_OWNER_NONE) ?
+                                   slot_front(slot_at(ctx, owner))->data[ch] : 0;
+            count++;
+            bits &= bits - 1;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Per-channel priority merge
+ * 
+ * Each channel is taken only from the sources that win it in
+ * channel_winners. HTP and LTP combine the winners; the other modes pick one
+ * winner per channel in their usual order of preference.
+ */
+static uint16_t merge_per_channel(merge_context_t *ctx, uint16_t lo, uint16_t hi)
+{
+    uint32_t driven[CHANNEL_MAP_WORDS] = {0};
+    uint32_t valid = 0;
+    
+    for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+        if (slot_at(ctx, i) && slot_at(ctx, i)->is_valid) {
+            valid |= 1UL << i;
+            for (int w = 0; w < CHANNEL_MAP_WORDS; w++) {
+                driven[w] |= ctx->channel_winners[i][w];
+            }
+        }
+    }
+    
+    // The newest source can change on any frame, so LAST redoes the whole span
+    merge_mode_t mode = ctx->span->mode;
+    if (mode == MERGE_MODE_LAST) {
+        lo = ctx->span->lo;
+        hi = ctx->span->hi;
+    }
+    
+    ctx->output_active = (valid != 0);
+    ctx->selected_source = -1;
+    memset(ctx->merged_data + lo, 0, hi - lo);
+    
+    if (mode == MERGE_MODE_HTP || mode == MERGE_MODE_LTP) {
+        bool htp = (mode == MERGE_MODE_HTP);
+        if (!htp) {
+            // Undriven channels stay at 0
+            for (int ch = lo; ch < hi; ch++) {
+                if (driven[ch >> 5] & (1UL << (ch & 31))) {
+                    ctx->merged_data[ch] = 255;
+                }
+            }
+        }
+        
+        for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+            if (!(valid & (1UL << i))) {
+                continue;
+            }
+            const uint8_t *src = slot_front(slot_at(ctx, i))->data;
+            const uint32_t *wins = ctx->channel_winners[i];
+            
+            for (int ch = lo; ch < hi; ch++) {
+                if (!(wins[ch >> 5] & (1UL << (ch & 31)))) {
+                    continue;
+                }
+                if (htp ? (src[ch] > ctx->merged_data[ch]) :
+                          (src[ch] < ctx->merged_data[ch])) {
+                    ctx->merged_data[ch] = src[ch];
+                }
+            }
+        }
+        return hi - lo;
+    }
+    
+    // LATEST: the winner that changed the channel last
+    if (mode == MERGE_MODE_LATEST) {
+        for (int ch = lo; ch < hi; ch++) {
+            int owner = LATEST_OWNER_NONE;
+            for (int i = 0; i < MERGE_MAX_SOURCES; i++) {
+                if ((valid & (1UL << i)) &&
+                    (ctx->channel_winners[i][ch >> 5] & (1UL << (ch & 31))) &&
+                    (owner == LATEST_OWNER_NONE || latest_is_newer(ctx, i, owner, ch))) {
+                    owner = i;
+                }
+            }
+            if (owner != LATEST_OWNER_NONE) {
+                ctx->merged_data[ch] = slot_front(slot_at(ctx, owner))->data[ch];
+            }
+        }
+        return hi - lo;
+    }
+    
+    // Pick one winner per channel in the mode's order of preference
+    int order[MERGE_MAX_SOURCES];
+    int count = build_source_order(ctx, valid, order);
+    
+    for (int ch = lo; ch < hi; ch++) {
+        for (int k = 0; k < count; k++) {
+            if (ctx->channel_winners[order[k]][ch >> 5] & (1UL << (ch & 31))) {
+                ctx->merged_data[ch] = slot_front(slot_at(ctx, order[k]))->data[ch];
+                break;
+            }
+        }
+    }
+    
+    return hi - lo;
 }
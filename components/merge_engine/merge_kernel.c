@@ -0,0 +1,149 @@
+/**
+ * @file merge_kernel.c
+ * @brief HTP/LTP channel kernels
+ * 
+ * The scalar byte loop compares one channel at a time with a branch. These
+ * kernels process 16 channels per step with SSE2/NEON on host builds and 4
+ * channels per 32-bit word (SWAR) on the ESP32-S3.
+ * 
+ * The S3 PIE vector unit only provides signed 8-bit max/min (EE.VMAX.S8) and
+ * needs 16-byte aligned operands through inline assembly, so the target uses
+ * the portable SWAR path instead.
+ * 
+ * The host tests (test/host) build and benchmark these kernels; defining
+ * MERGE_KERNEL_FORCE_SWAR selects the target's SWAR path on any machine.
+ */
+
+#include "merge_kernel.h"
+#include <string.h>
+
+#if defined(MERGE_KERNEL_FORCE_SWAR)
+#define MERGE_KERNEL_SWAR 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MERGE_KERNEL_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MERGE_KERNEL_NEON 1
+#else
+#define MERGE_KERNEL_SWAR 1
+#endif
+
+#if MERGE_KERNEL_SWAR
+
+#define SWAR_HIGH 0x80808080U
+
+/**
+ * @brief Per-byte mask, 0xFF where a >= b (unsigned), 0x00 elsewhere
+ * 
+ * The low 7 bits of each byte are compared with a borrow-free subtraction,
+ * the top bits decide when they differ.
+ */
+static inline uint32_t swar_ge_mask(uint32_t a, uint32_t b)
+{
+    uint32_t low = (a | SWAR_HIGH) - (b & ~SWAR_HIGH);
+    uint32_t ge = ((a & ~b) | (~(a ^ b) & low)) & SWAR_HIGH;
+    return (ge >> 7) * 0xFF;
+}
+
+// Callers guarantee 4-byte alignment, so these compile to single word accesses
+static inline uint32_t load32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, __builtin_assume_aligned(p, 4), sizeof(v));
+    return v;
+}
+
+static inline void store32(uint8_t *p, uint32_t v)
+{
+    memcpy(__builtin_assume_aligned(p, 4), &v, sizeof(v));
+}
+
+#endif
+
+void merge_kernel_max(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t i = 0;
+
+#if MERGE_KERNEL_SSE2
+    for (; i + 16 <= len; i += 16) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_max_epu8(d, s));
+    }
+#elif MERGE_KERNEL_NEON
+    for (; i + 16 <= len; i += 16) {
+        vst1q_u8(dst + i, vmaxq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+    }
+#else
+    // Word loop only when both sides can reach 4-byte alignment together
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0) {
+        for (; i < len && ((uintptr_t)(dst + i) & 3); i++) {
+            if (src[i] > dst[i]) {
+                dst[i] = src[i];
+            }
+        }
+        for (; i + 4 <= len; i += 4) {
+            uint32_t d = load32(dst + i);
+            uint32_t s = load32(src + i);
+            uint32_t mask = swar_ge_mask(d, s);
+            store32(dst + i, (d & mask) | (s & ~mask));
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (src[i] > dst[i]) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+void merge_kernel_min(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t i = 0;
+
+#if MERGE_KERNEL_SSE2
+    for (; i + 16 <= len; i += 16) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_min_epu8(d, s));
+    }
+#elif MERGE_KERNEL_NEON
+    for (; i + 16 <= len; i += 16) {
+        vst1q_u8(dst + i, vminq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+    }
+#else
+    // Word loop only when both sides can reach 4-byte alignment together
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0) {
+        for (; i < len && ((uintptr_t)(dst + i) & 3); i++) {
+            if (src[i] < dst[i]) {
+                dst[i] = src[i];
+            }
+        }
+        for (; i + 4 <= len; i += 4) {
+            uint32_t d = load32(dst + i);
+            uint32_t s = load32(src + i);
+            uint32_t mask = swar_ge_mask(d, s);
+            store32(dst + i, (s & mask) | (d & ~mask));
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (src[i] < dst[i]) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+const char* merge_kernel_name(void)
+{
+#if MERGE_KERNEL_SSE2
+    return "sse2";
+#elif MERGE_KERNEL_NEON
+    return "neon";
+#else
+    return "swar32";
+#endif
+}
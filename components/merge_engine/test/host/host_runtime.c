@@ -0,0 +1,65 @@
+/**
+ * @file host_runtime.c
+ * @brief FreeRTOS and ESP-IDF functions the merge engine needs, on POSIX
+ * 
+ * Mutexes map to pthread mutexes, the esp_timer clock to CLOCK_MONOTONIC
+ * and capability allocation to the plain heap, so the engine's source code
+ * builds unchanged on the host.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+struct host_mutex {
+    pthread_mutex_t mutex;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t handle = malloc(sizeof(*handle));
+    if (handle) {
+        pthread_mutex_init(&handle->mutex, NULL);
+    }
+    return handle;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks)
+{
+    (void)ticks;  // The engine only waits forever
+    pthread_mutex_lock(&mutex->mutex);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+    pthread_mutex_unlock(&mutex->mutex);
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t mutex)
+{
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+    (void)caps;
+    return calloc(n, size);
+}
+
+void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
@@ -0,0 +1,16 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Host stand-in for capability-based allocation (plain heap)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_INTERNAL (1 << 0)
+#define MALLOC_CAP_8BIT     (1 << 1)
+#define MALLOC_CAP_SPIRAM   (1 << 2)
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
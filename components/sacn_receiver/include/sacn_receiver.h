@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "esp_err.h"
+#include "sequence_tracker.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,26 +22,44 @@ extern "C" {
  * 
  * Features:
  * - Receives sACN DMX data packets
- * - Multicast universe subscription
- * - Priority handling (0-200)
- * - Sequence number validation
+ * - Multicast universe subscription: hashed table for hundreds of universes,
+ *   batched updates that only join and leave what changed
+ * - Priority handling (0-200), including per-address priority (start code 0xDD)
+ * - Per-source sequence validation: late and duplicate packets are dropped
  * - Preview data detection
  * - Source name tracking
+ * - Stream termination: a source that signs off is reported at once
+ * - Universe synchronization: data with a sync address is held until the
+ *   matching sync packet, falling back to immediate after 2.5 s without one
  */
 
 // sACN constants
 #define SACN_PORT 5568
+#define SACN_CID_LENGTH 16
+#define SACN_SOURCE_NAME_LENGTH 64
 #define SACN_MULTICAST_BASE "239.255.0.0"
-#define SACN_MAX_UNIVERSES 8  // Maximum universes to subscribe
+#define SACN_MAX_UNIVERSES 256  // Maximum universes to subscribe
+#define SACN_MAX_SYNC_ADDRESSES 2  // Sync universes followed at once
+#define SACN_SYNC_SOURCES 4        // Sources per universe held for a sync packet
+
+// Without a sync packet for this long, synchronized data is output
+// immediately (E131_NETWORK_DATA_LOSS_TIMEOUT)
+#define SACN_SYNC_TIMEOUT_MS 2500
 
 // sACN packet identifier
 #define SACN_PACKET_IDENTIFIER "ASC-E1.17\0\0\0"
 
 // sACN vectors
 #define SACN_ROOT_VECTOR    0x00000004
+#define SACN_ROOT_VECTOR_EXTENDED 0x00000008  // Sync and discovery packets
 #define SACN_FRAME_VECTOR   0x00000002
+#define SACN_FRAME_VECTOR_SYNC 0x00000001
 #define SACN_DMP_VECTOR     0x02
 
+// DMX512 start codes carried in the DMP layer
+#define SACN_START_CODE_DMX      0x00
+#define SACN_START_CODE_PRIORITY 0xDD  // Per-address priority
+
 // sACN options flags
 #define SACN_OPT_PREVIEW    0x80
 #define SACN_OPT_STREAM_TERM 0x40
@@ -54,7 +73,7 @@ typedef struct __attribute__((packed)) {
     uint8_t acn_pid[12];         /**< ACN Packet Identifier */
     uint16_t flags_length;       /**< Flags (0x7) + PDU length */
     uint32_t vector;             /**< Root vector (0x00000004) */
-    uint8_t cid[16];             /**< Component ID (UUID) */
+    uint8_t cid[SACN_CID_LENGTH]; /**< Component ID (UUID) */
 } sacn_root_layer_t;
 
 /**
@@ -63,7 +82,8 @@ typedef struct __attribute__((packed)) {
 typedef struct __attribute__((packed)) {
     uint16_t flags_length;       /**< Flags + PDU length */
     uint32_t vector;             /**< Framing vector (0x00000002) */
-    char source_name[64];        /**< Source name (UTF-8, null terminated) */
+    char source_name[SACN_SOURCE_NAME_LENGTH]; /**< Source name (UTF-8, null terminated
+                                                    unless all bytes are used) */
     uint8_t priority;            /**< Priority (0-200, default 100) */
     uint16_t sync_address;       /**< Synchronization universe (0 = none) */
     uint8_t sequence_number;     /**< Sequence number (0-255) */
@@ -81,8 +101,8 @@ typedef struct __attribute__((packed)) {
     uint16_t first_address;      /**< First property address (0x0000) */
     uint16_t address_increment;  /**< Address increment (0x0001) */
     uint16_t property_count;     /**< Property value count (1-513) */
-    uint8_t start_code;          /**< DMX512 start code (0x00) */
-    uint8_t data[512];           /**< DMX data (512 channels) */
+    uint8_t start_code;          /**< DMX512 start code (0x00 or 0xDD) */
+    uint8_t data[512];           /**< DMX data or per-address priorities */
 } sacn_dmp_layer_t;
 
 /**
@@ -94,6 +114,25 @@ typedef struct __attribute__((packed)) {
     sacn_dmp_layer_t dmp;        /**< DMP layer */
 } sacn_packet_t;
 
+/**
+ * @brief sACN Synchronization Framing Layer
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t flags_length;       /**< Flags + PDU length */
+    uint32_t vector;             /**< Framing vector (0x00000001) */
+    uint8_t sequence_number;     /**< Sequence number (0-255) */
+    uint16_t sync_address;       /**< Synchronization universe */
+    uint8_t reserved[2];         /**< Transmit as zero */
+} sacn_sync_framing_layer_t;
+
+/**
+ * @brief sACN synchronization packet
+ */
+typedef struct __attribute__((packed)) {
+    sacn_root_layer_t root;      /**< Root layer (extended vector) */
+    sacn_sync_framing_layer_t framing; /**< Synchronization framing layer */
+} sacn_sync_packet_t;
+
 /**
  * @brief sACN receiver statistics
  */
@@ -102,7 +141,15 @@ typedef struct {
     uint32_t data_packets;        /**< Data packets received */
     uint32_t preview_packets;     /**< Preview packets received */
     uint32_t invalid_packets;     /**< Invalid packets */
-    uint32_t sequence_errors;     /**< Sequence number errors */
+    uint32_t sequence_errors;     /**< Packets out of sequence (gaps and drops) */
+    uint32_t sequence_drops;      /**< Late or duplicate packets discarded */
+    uint32_t priority_packets;    /**< Per-address priority (0xDD) packets */
+    uint32_t unrouted_packets;    /**< Packets for universes no port outputs */
+    uint32_t sync_packets;        /**< Synchronization packets received */
+    uint32_t staged_frames;       /**< Data frames held for a sync packet */
+    uint32_t sync_timeouts;       /**< Fallbacks to immediate output */
+    uint32_t staged_drops;        /**< Synchronized frames dropped, staging full */
+    uint32_t terminated_packets;  /**< Packets with the Stream_Terminated option */
 } sacn_stats_t;
 
 /**
@@ -112,14 +159,66 @@ typedef struct {
  * @param priority Priority (0-200)
  * @param sequence Sequence number
  * @param preview true if preview data
- * @param source_name Source name (null terminated)
+ * @param source_name Source name (up to SACN_SOURCE_NAME_LENGTH bytes, not
+ *                    terminated if the name fills the field)
+ * @param cid Source component ID (SACN_CID_LENGTH bytes)
  * @param source_ip Source IP address (network byte order)
  * @param user_data User data pointer
  */
 typedef void (*sacn_dmx_callback_t)(uint16_t universe, const uint8_t *data,
                                     uint8_t priority, uint8_t sequence,
                                     bool preview, const char *source_name,
-                                    uint32_t source_ip, void *user_data);
+                                    const uint8_t *cid, uint32_t source_ip,
+                                    void *user_data);
+
+/**
+ * @brief sACN per-address priority callback (start code 0xDD)
+ * @param universe Universe number (1-63999)
+ * @param priorities Per-channel priorities (512 entries, 0 = not driven)
+ * @param sequence Sequence number
+ * @param source_name Source name (up to SACN_SOURCE_NAME_LENGTH bytes, not
+ *                    terminated if the name fills the field)
+ * @param cid Source component ID (SACN_CID_LENGTH bytes)
+ * @param source_ip Source IP address (network byte order)
+ * @param user_data User data pointer
+ */
+typedef void (*sacn_priority_callback_t)(uint16_t universe, const uint8_t *priorities,
+                                         uint8_t sequence, const char *source_name,
+                                         const uint8_t *cid, uint32_t source_ip,
+                                         void *user_data);
+
+/**
+ * @brief sACN stream terminated callback
+ * 
+ * Called for each packet with the Stream_Terminated option. The source sends
+ * it (usually three times) when it stops transmitting a universe; its data
+ * is not delivered.
+ * 
+ * @param universe Universe number (1-63999)
+ * @param cid Source component ID (SACN_CID_LENGTH bytes)
+ * @param source_ip Source IP address (network byte order)
+ * @param user_data User data pointer
+ */
+typedef void (*sacn_terminate_callback_t)(uint16_t universe, const uint8_t *cid,
+                                          uint32_t source_ip, void *user_data);
+
+/**
+ * @brief sACN synchronization callback
+ * 
+ * Called after the frames held for a sync address have been passed to the
+ * DMX callback, so the receiver of both can update all outputs at once.
+ * Lists every universe whose data carried this sync address, whether or
+ * not a frame of it was held for this sync packet.
+ * 
+ * @param sync_address Synchronization universe
+ * @param universes Universes synchronized by this address
+ * @param universe_count Number of universes
+ * @param source_ip Source IP address (network byte order)
+ * @param user_data User data pointer
+ */
+typedef void (*sacn_sync_callback_t)(uint16_t sync_address, const uint16_t *universes,
+                                     uint8_t universe_count, uint32_t source_ip,
+                                     void *user_data);
 
 /**
  * @brief Initialize sACN receiver
@@ -146,8 +245,8 @@ esp_err_t sacn_receiver_deinit(void);
 /**
  * @brief Start sACN receiver
  * 
- * Starts the UDP receiver task on port 5568.
- * Receiver must be initialized first.
+ * Binds UDP port 5568 and hands the socket to the UDP dispatcher.
+ * Receiver and UDP dispatcher must be initialized first.
  * 
  * @return
  *     - ESP_OK on success
@@ -159,8 +258,8 @@ esp_err_t sacn_receiver_start(void);
 /**
  * @brief Stop sACN receiver
  * 
- * Stops the receiver task and closes the socket.
- * Unsubscribes from all multicast groups.
+ * Unsubscribes from all multicast groups and hands the socket back to the
+ * UDP dispatcher, which closes it.
  * 
  * @return
  *     - ESP_OK on success
@@ -197,6 +296,25 @@ esp_err_t sacn_receiver_subscribe_universe(uint16_t universe);
  */
 esp_err_t sacn_receiver_unsubscribe_universe(uint16_t universe);
 
+/**
+ * @brief Replace the subscribed universes with a new set
+ * 
+ * Applies the change as one batch: universes in both sets stay joined,
+ * and only the difference is left or joined (leaves first), so a routing
+ * rebuild causes no IGMP traffic for universes it keeps. Out-of-range
+ * universes are skipped.
+ * 
+ * @param universes Universes to subscribe (1-63999)
+ * @param count Number of universes (0 leaves all)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if universes is NULL and count is not 0
+ *     - ESP_ERR_INVALID_STATE if not running
+ *     - ESP_ERR_NO_MEM if more than SACN_MAX_UNIVERSES were requested
+ *     - ESP_FAIL if a multicast join failed (the others are still applied)
+ */
+esp_err_t sacn_receiver_set_universes(const uint16_t *universes, uint16_t count);
+
 /**
  * @brief Register DMX data callback
  * 
@@ -212,6 +330,51 @@ esp_err_t sacn_receiver_unsubscribe_universe(uint16_t universe);
  */
 esp_err_t sacn_receiver_set_callback(sacn_dmx_callback_t callback, void *user_data);
 
+/**
+ * @brief Register per-address priority callback
+ * 
+ * Registers a callback for per-address priority packets (start code 0xDD).
+ * Without one, these packets are counted and dropped.
+ * 
+ * @param callback Callback function
+ * @param user_data User data pointer passed to callback
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if callback is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t sacn_receiver_set_priority_callback(sacn_priority_callback_t callback,
+                                              void *user_data);
+
+/**
+ * @brief Register synchronization callback
+ * 
+ * The receiver joins the multicast group of each sync address it sees in
+ * data packets. Without a callback, held frames are still released on the
+ * sync packet.
+ * 
+ * @param callback Callback function
+ * @param user_data User data pointer passed to callback
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if callback is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t sacn_receiver_set_sync_callback(sacn_sync_callback_t callback, void *user_data);
+
+/**
+ * @brief Register stream terminated callback
+ * 
+ * @param callback Callback function
+ * @param user_data User data pointer passed to callback
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if callback is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t sacn_receiver_set_terminate_callback(sacn_terminate_callback_t callback,
+                                               void *user_data);
+
 /**
  * @brief Get receiver statistics
  * 
@@ -225,6 +388,18 @@ esp_err_t sacn_receiver_set_callback(sacn_dmx_callback_t callback, void *user_da
  */
 esp_err_t sacn_receiver_get_stats(sacn_stats_t *stats);
 
+/**
+ * @brief Get per-source sequence statistics
+ * 
+ * One entry per (CID, universe, start code) stream seen recently.
+ * 
+ * @param sources Output array
+ * @param max_sources Size of output array
+ * @return Number of streams written
+ */
+uint8_t sacn_receiver_get_source_stats(sequence_source_stats_t *sources,
+                                       uint8_t max_sources);
+
 /**
  * @brief Check if receiver is running
  * 
@@ -237,7 +412,7 @@ bool sacn_receiver_is_running(void);
  * 
  * @return Number of currently subscribed universes
  */
-uint8_t sacn_receiver_get_subscription_count(void);
+uint16_t sacn_receiver_get_subscription_count(void);
 
 #ifdef __cplusplus
 }
@@ -4,19 +4,26 @@
  * 
  * This component receives sACN packets over UDP multicast and processes them.
  * It handles E1.31 data packets with priority, sequence validation, and preview detection.
+ * Per-address priority packets (start code 0xDD) go to a separate callback.
+ * Data packets with a sync address are held and released together when the
+ * synchronization packet for that address arrives (E1.31 section 11).
  * 
  * Thread Safety:
  * - All public APIs are thread-safe using mutexes
- * - Receiver runs on dedicated task (Core 0)
- * - Callbacks executed from receiver task context
+ * - Packets are received on the shared UDP dispatcher task (Core 0)
+ * - Callbacks executed from dispatcher task context
  * 
  * Memory Usage:
- * - ~3KB for context and buffers
- * - Task stack: 4KB
- * - Total: ~7KB
+ * - ~2KB for context
+ * - ~2KB for the subscription table (256 universes)
+ * - ~9.4KB for frames held for sync packets (16 with two ports)
+ * - ~1.5KB for the sequence tracker
+ * - Total: ~15KB
  */
 
 #include "sacn_receiver.h"
+#include "universe_router.h"
+#include "udp_dispatcher.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_netif.h"
@@ -31,27 +38,65 @@
 
 static const char *TAG = "sacn_receiver";
 
-// Task configuration
-#define SACN_TASK_STACK_SIZE 4096
-#define SACN_TASK_PRIORITY   5
-#define SACN_TASK_CORE       0
+// A source silent this long restarts its sequence (E131_NETWORK_DATA_LOSS_TIMEOUT)
+#define SACN_SEQUENCE_TIMEOUT_MS 2500
 
-// Buffer sizes
-#define SACN_MAX_PACKET_SIZE 638  // Full sACN packet size
+// Subscription hash table size (power of two, at most half full)
+#define SACN_SUBSCRIPTION_TABLE_SIZE (2 * SACN_MAX_UNIVERSES)
 
-// Timeout
-#define SACN_RECEIVE_TIMEOUT_MS 1000
+// Universes one sync address can synchronize; only routed universes are held
+#define SACN_SYNC_UNIVERSES (UNIVERSE_ROUTER_PORTS * UNIVERSE_ROUTER_PORT_UNIVERSES)
+
+// Frames held for sync packets: each routed universe from SACN_SYNC_SOURCES sources
+#define SACN_MAX_STAGED_FRAMES (SACN_SYNC_UNIVERSES * SACN_SYNC_SOURCES)
+
+/**
+ * @brief Subscription state
+ */
+typedef enum {
+    SUBSCRIPTION_EMPTY = 0,
+    SUBSCRIPTION_JOINED,           // Multicast group joined
+    SUBSCRIPTION_LEAVING           // Batch update: not in the new set
+} subscription_state_t;
 
 /**
- * @brief Universe subscription entry
+ * @brief Universe subscription entry (open-addressed, linear probing)
+ * 
+ * The multicast group follows from the universe, so it is not stored.
  */
 typedef struct {
     uint16_t universe;
-    bool subscribed;
-    uint8_t last_sequence;
-    struct ip_mreq mreq;
+    uint8_t state;
 } universe_subscription_t;
 
+/**
+ * @brief Synchronization universe followed by the receiver
+ */
+typedef struct {
+    uint16_t sync_address;         // 0 = unused
+    bool synced;                   // Sync packets seen within the timeout
+    bool joined;                   // Multicast group joined for this address
+    uint64_t last_sync_us;
+    struct ip_mreq mreq;
+    uint16_t universes[SACN_SYNC_UNIVERSES]; // Universes seen with this address
+    uint8_t universe_count;
+} sync_group_t;
+
+/**
+ * @brief Data frame held until its sync packet
+ */
+typedef struct {
+    bool used;
+    uint16_t sync_address;
+    uint16_t universe;
+    uint8_t priority;
+    uint8_t sequence;
+    uint32_t source_ip;
+    uint8_t cid[SACN_CID_LENGTH];
+    char source_name[SACN_SOURCE_NAME_LENGTH];
+    uint8_t data[512];
+} staged_frame_t;
+
 /**
  * @brief Module state
  */
@@ -60,13 +105,27 @@ static struct {
     bool running;
     
     int socket_fd;
-    TaskHandle_t task_handle;
     
     sacn_dmx_callback_t dmx_callback;
     void *dmx_callback_user_data;
     
-    universe_subscription_t subscriptions[SACN_MAX_UNIVERSES];
-    uint8_t subscription_count;
+    sacn_priority_callback_t priority_callback;
+    void *priority_callback_user_data;
+    
+    sacn_sync_callback_t sync_callback;
+    void *sync_callback_user_data;
+    
+    sacn_terminate_callback_t terminate_callback;
+    void *terminate_callback_user_data;
+    
+    // Universe synchronization (receive task only)
+    sync_group_t sync_groups[SACN_MAX_SYNC_ADDRESSES];
+    staged_frame_t staged[SACN_MAX_STAGED_FRAMES];
+    
+    universe_subscription_t subscriptions[SACN_SUBSCRIPTION_TABLE_SIZE];
+    uint16_t subscription_count;
+    
+    sequence_tracker_t sequence;   // Per-source sequence (receive task only)
     
     sacn_stats_t stats;
     
@@ -79,11 +138,17 @@ static struct {
 };
 
 // Forward declarations
-static void sacn_receive_task(void *arg);
+static void sacn_handle_datagram(const uint8_t *data, size_t length,
+                                   const struct sockaddr_in *src_addr, void *user_data);
 static esp_err_t process_sacn_packet(const uint8_t *buffer, size_t length,
                                      const struct sockaddr_in *src_addr);
 static esp_err_t process_sacn_data(const sacn_packet_t *packet,
                                    const struct sockaddr_in *src_addr);
+static esp_err_t process_sacn_sync(const sacn_sync_packet_t *packet,
+                                   const struct sockaddr_in *src_addr);
+static bool stage_sync_frame(const sacn_packet_t *packet, const char *source_name,
+                             uint32_t source_ip);
+static void drop_staged_frames(uint16_t universe, const uint8_t *cid);
 static void calculate_multicast_addr(uint16_t universe, struct in_addr *addr);
 
 /**
@@ -102,6 +167,107 @@ static void calculate_multicast_addr(uint16_t universe, struct in_addr *addr)
     addr->s_addr = htonl(0xEFFF0000 | (octet3 << 8) | octet4);
 }
 
+/**
+ * @brief Join or leave the multicast group of a universe
+ */
+static bool set_membership(uint16_t universe, bool join)
+{
+    struct ip_mreq mreq = {
+        .imr_interface.s_addr = INADDR_ANY
+    };
+    calculate_multicast_addr(universe, &mreq.imr_multiaddr);
+    
+    return setsockopt(sacn_state.socket_fd, IPPROTO_IP,
+                      join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP,
+                      &mreq, sizeof(mreq)) == 0;
+}
+
+/**
+ * @brief Hash a universe to its home slot in the subscription table
+ */
+static inline uint32_t subscription_hash(uint16_t universe)
+{
+    return (universe * 2654435761u) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1);
+}
+
+/**
+ * @brief Find the subscription of a universe, or NULL
+ */
+static universe_subscription_t* find_subscription(uint16_t universe)
+{
+    uint32_t index = subscription_hash(universe);
+    
+    for (int probe = 0; probe < SACN_SUBSCRIPTION_TABLE_SIZE; probe++) {
+        universe_subscription_t *sub =
+            &sacn_state.subscriptions[(index + probe) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1)];
+        if (sub->state == SUBSCRIPTION_EMPTY) {
+            return NULL;
+        }
+        if (sub->universe == universe) {
+            return sub;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Add a universe to the subscription table
+ * 
+ * @return The new entry, NULL if SACN_MAX_UNIVERSES are subscribed
+ */
+static universe_subscription_t* insert_subscription(uint16_t universe, subscription_state_t state)
+{
+    if (sacn_state.subscription_count >= SACN_MAX_UNIVERSES) {
+        return NULL;
+    }
+    
+    uint32_t index = subscription_hash(universe);
+    universe_subscription_t *sub = &sacn_state.subscriptions[index];
+    while (sub->state != SUBSCRIPTION_EMPTY) {
+        index = (index + 1) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1);
+        sub = &sacn_state.subscriptions[index];
+    }
+    
+    sub->universe = universe;
+    sub->state = state;
+    sacn_state.subscription_count++;
+    
+    return sub;
+}
+
+/**
+ * @brief Remove an entry from the subscription table
+ * 
+ * Later entries of the probe chain are shifted back into the hole, so the
+ * table needs no tombstones and lookups stay short however often the
+ * subscriptions change.
+ */
+static void remove_subscription(universe_subscription_t *sub)
+{
+    uint32_t hole = sub - sacn_state.subscriptions;
+    uint32_t index = hole;
+    
+    for (;;) {
+        index = (index + 1) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1);
+        universe_subscription_t *next = &sacn_state.subscriptions[index];
+        if (next->state == SUBSCRIPTION_EMPTY) {
+            break;
+        }
+        
+        // Move the entry unless its home slot lies between the hole and it
+        uint32_t home = subscription_hash(next->universe);
+        if (((index - home) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1)) >=
+            ((index - hole) & (SACN_SUBSCRIPTION_TABLE_SIZE - 1))) {
+            sacn_state.subscriptions[hole] = *next;
+            hole = index;
+        }
+    }
+    
+    sacn_state.subscriptions[hole].state = SUBSCRIPTION_EMPTY;
+    sacn_state.subscription_count--;
+}
+
 /**
  * @brief Validate sACN packet header
  */
@@ -138,14 +304,32 @@ static bool validate_sacn_header(const uint8_t *buffer, size_t length)
         return false;
     }
     
-    // Check start code (DMX)
-    if (packet->dmp.start_code != 0x00) {
+    // Check start code (DMX levels or per-address priority)
+    if (packet->dmp.start_code != SACN_START_CODE_DMX &&
+        packet->dmp.start_code != SACN_START_CODE_PRIORITY) {
         return false;
     }
     
     return true;
 }
 
+/**
+ * @brief Check for a synchronization packet
+ */
+static bool is_sync_packet(const uint8_t *buffer, size_t length)
+{
+    if (length < sizeof(sacn_sync_packet_t)) {
+        return false;
+    }
+    
+    const sacn_sync_packet_t *packet = (const sacn_sync_packet_t *)buffer;
+    
+    return ntohs(packet->root.preamble_size) == 0x0010 &&
+           memcmp(packet->root.acn_pid, SACN_PACKET_IDENTIFIER, 12) == 0 &&
+           ntohl(packet->root.vector) == SACN_ROOT_VECTOR_EXTENDED &&
+           ntohl(packet->framing.vector) == SACN_FRAME_VECTOR_SYNC;
+}
+
 // ============================================================================
 // Public API Implementation
 // ============================================================================
@@ -170,6 +354,7 @@ esp_err_t sacn_receiver_init(void)
     memset(&sacn_state.stats, 0, sizeof(sacn_stats_t));
     memset(sacn_state.subscriptions, 0, sizeof(sacn_state.subscriptions));
     sacn_state.subscription_count = 0;
+    sequence_tracker_init(&sacn_state.sequence, SEQUENCE_MODE_E131, SACN_SEQUENCE_TIMEOUT_MS);
     
     sacn_state.initialized = true;
     ESP_LOGI(TAG, "sACN receiver initialized successfully");
@@ -229,13 +414,6 @@ esp_err_t sacn_receiver_start(void)
     int opt = 1;
     setsockopt(sacn_state.socket_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
     
-    // Set receive timeout
-    struct timeval timeout = {
-        .tv_sec = SACN_RECEIVE_TIMEOUT_MS / 1000,
-        .tv_usec = (SACN_RECEIVE_TIMEOUT_MS % 1000) * 1000
-    };
-    setsockopt(sacn_state.socket_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-    
     // Bind to sACN port
     struct sockaddr_in addr = {
         .sin_family = AF_INET,
@@ -251,19 +429,10 @@ esp_err_t sacn_receiver_start(void)
         return ESP_FAIL;
     }
     
-    // Create receiver task
-    BaseType_t ret = xTaskCreatePinnedToCore(
-        sacn_receive_task,
-        "sacn_rx",
-        SACN_TASK_STACK_SIZE,
-        NULL,
-        SACN_TASK_PRIORITY,
-        &sacn_state.task_handle,
-        SACN_TASK_CORE
-    );
-    
-    if (ret != pdPASS) {
-        ESP_LOGE(TAG, "Failed to create receiver task");
+    // Datagrams are received and batched by the shared dispatcher task
+    esp_err_t ret = udp_dispatcher_register(sacn_state.socket_fd, sacn_handle_datagram, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register socket: %s", esp_err_to_name(ret));
         close(sacn_state.socket_fd);
         sacn_state.socket_fd = -1;
         xSemaphoreGive(sacn_state.mutex);
@@ -294,29 +463,32 @@ esp_err_t sacn_receiver_stop(void)
     xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
     
     // Unsubscribe from all multicast groups
-    for (int i = 0; i < sacn_state.subscription_count; i++) {
-        if (sacn_state.subscriptions[i].subscribed && sacn_state.socket_fd >= 0) {
+    for (int i = 0; i < SACN_SUBSCRIPTION_TABLE_SIZE; i++) {
+        if (sacn_state.subscriptions[i].state == SUBSCRIPTION_JOINED && sacn_state.socket_fd >= 0) {
+            set_membership(sacn_state.subscriptions[i].universe, false);
+        }
+    }
+    memset(sacn_state.subscriptions, 0, sizeof(sacn_state.subscriptions));
+    sacn_state.subscription_count = 0;
+    for (int i = 0; i < SACN_MAX_SYNC_ADDRESSES; i++) {
+        if (sacn_state.sync_groups[i].joined && sacn_state.socket_fd >= 0) {
             setsockopt(sacn_state.socket_fd, IPPROTO_IP, IP_DROP_MEMBERSHIP,
-                      &sacn_state.subscriptions[i].mreq, sizeof(struct ip_mreq));
+                      &sacn_state.sync_groups[i].mreq, sizeof(struct ip_mreq));
         }
     }
+    memset(sacn_state.sync_groups, 0, sizeof(sacn_state.sync_groups));
+    memset(sacn_state.staged, 0, sizeof(sacn_state.staged));
     
     sacn_state.running = false;
     
-    // Close socket (this will unblock the receive task)
+    // The dispatcher closes the socket once it stops waiting on it
     if (sacn_state.socket_fd >= 0) {
-        close(sacn_state.socket_fd);
+        udp_dispatcher_unregister(sacn_state.socket_fd);
         sacn_state.socket_fd = -1;
     }
     
     xSemaphoreGive(sacn_state.mutex);
     
-    // Wait for task to terminate
-    if (sacn_state.task_handle) {
-        vTaskDelay(pdMS_TO_TICKS(100));
-        sacn_state.task_handle = NULL;
-    }
-    
     ESP_LOGI(TAG, "sACN receiver stopped");
     
     return ESP_OK;
@@ -339,52 +511,30 @@ esp_err_t sacn_receiver_subscribe_universe(uint16_t universe)
     xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
     
     // Check if already subscribed
-    for (int i = 0; i < sacn_state.subscription_count; i++) {
-        if (sacn_state.subscriptions[i].universe == universe &&
-            sacn_state.subscriptions[i].subscribed) {
-            ESP_LOGW(TAG, "Already subscribed to universe %d", universe);
-            xSemaphoreGive(sacn_state.mutex);
-            return ESP_OK;
-        }
+    if (find_subscription(universe)) {
+        ESP_LOGW(TAG, "Already subscribed to universe %d", universe);
+        xSemaphoreGive(sacn_state.mutex);
+        return ESP_OK;
     }
     
     // Check if we have space for more subscriptions
-    if (sacn_state.subscription_count >= SACN_MAX_UNIVERSES) {
+    universe_subscription_t *sub = insert_subscription(universe, SUBSCRIPTION_JOINED);
+    if (!sub) {
         ESP_LOGE(TAG, "Maximum universes reached");
         xSemaphoreGive(sacn_state.mutex);
         return ESP_ERR_NO_MEM;
     }
     
-    // Calculate multicast address
-    struct in_addr multicast_addr;
-    calculate_multicast_addr(universe, &multicast_addr);
-    
-    // Prepare multicast request
-    struct ip_mreq mreq = {
-        .imr_multiaddr = multicast_addr,
-        .imr_interface.s_addr = INADDR_ANY
-    };
-    
     // Join multicast group
-    if (setsockopt(sacn_state.socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP,
-                  &mreq, sizeof(mreq)) < 0) {
+    if (!set_membership(universe, true)) {
         ESP_LOGE(TAG, "Failed to join multicast group for universe %d: %d",
                  universe, errno);
+        remove_subscription(sub);
         xSemaphoreGive(sacn_state.mutex);
         return ESP_FAIL;
     }
     
-    // Add to subscriptions
-    universe_subscription_t *sub = &sacn_state.subscriptions[sacn_state.subscription_count];
-    sub->universe = universe;
-    sub->subscribed = true;
-    sub->last_sequence = 0;
-    sub->mreq = mreq;
-    
-    sacn_state.subscription_count++;
-    
-    ESP_LOGI(TAG, "Subscribed to universe %d (multicast %s)",
-             universe, inet_ntoa(multicast_addr));
+    ESP_LOGI(TAG, "Subscribed to universe %d", universe);
     
     xSemaphoreGive(sacn_state.mutex);
     
@@ -408,34 +558,19 @@ esp_err_t sacn_receiver_unsubscribe_universe(uint16_t universe)
     xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
     
     // Find subscription
-    int found_index = -1;
-    for (int i = 0; i < sacn_state.subscription_count; i++) {
-        if (sacn_state.subscriptions[i].universe == universe &&
-            sacn_state.subscriptions[i].subscribed) {
-            found_index = i;
-            break;
-        }
-    }
-    
-    if (found_index < 0) {
+    universe_subscription_t *sub = find_subscription(universe);
+    if (!sub) {
         ESP_LOGW(TAG, "Not subscribed to universe %d", universe);
         xSemaphoreGive(sacn_state.mutex);
         return ESP_ERR_NOT_FOUND;
     }
     
     // Leave multicast group
-    universe_subscription_t *sub = &sacn_state.subscriptions[found_index];
-    if (setsockopt(sacn_state.socket_fd, IPPROTO_IP, IP_DROP_MEMBERSHIP,
-                  &sub->mreq, sizeof(struct ip_mreq)) < 0) {
+    if (!set_membership(universe, false)) {
         ESP_LOGW(TAG, "Failed to leave multicast group: %d", errno);
     }
     
-    // Remove from array (shift remaining items)
-    for (int i = found_index; i < sacn_state.subscription_count - 1; i++) {
-        sacn_state.subscriptions[i] = sacn_state.subscriptions[i + 1];
-    }
-    
-    sacn_state.subscription_count--;
+    remove_subscription(sub);
     
     ESP_LOGI(TAG, "Unsubscribed from universe %d", universe);
     
@@ -444,6 +579,79 @@ esp_err_t sacn_receiver_unsubscribe_universe(uint16_t universe)
     return ESP_OK;
 }
 
+esp_err_t sacn_receiver_set_universes(const uint16_t *universes, uint16_t count)
+{
+    if (!sacn_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!sacn_state.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!universes && count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    
+    // Mark everything for leaving, then keep what the new set holds
+    for (int i = 0; i < SACN_SUBSCRIPTION_TABLE_SIZE; i++) {
+        if (sacn_state.subscriptions[i].state == SUBSCRIPTION_JOINED) {
+            sacn_state.subscriptions[i].state = SUBSCRIPTION_LEAVING;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        universe_subscription_t *sub = find_subscription(universes[i]);
+        if (sub) {
+            sub->state = SUBSCRIPTION_JOINED;
+        }
+    }
+    
+    // Leaves first, so the groups and entries they free are available to
+    // the joins. A removal may shift a later entry into the current slot,
+    // so the slot is looked at again.
+    uint16_t left = 0;
+    for (int i = 0; i < SACN_SUBSCRIPTION_TABLE_SIZE; i++) {
+        while (sacn_state.subscriptions[i].state == SUBSCRIPTION_LEAVING) {
+            set_membership(sacn_state.subscriptions[i].universe, false);
+            remove_subscription(&sacn_state.subscriptions[i]);
+            left++;
+        }
+    }
+    
+    esp_err_t ret = ESP_OK;
+    uint16_t joined = 0;
+    for (int i = 0; i < count; i++) {
+        uint16_t universe = universes[i];
+        if (universe < 1 || universe > 63999 || find_subscription(universe)) {
+            continue;
+        }
+        
+        universe_subscription_t *sub = insert_subscription(universe, SUBSCRIPTION_JOINED);
+        if (!sub) {
+            ret = ESP_ERR_NO_MEM;
+            break;
+        }
+        
+        if (set_membership(universe, true)) {
+            joined++;
+        } else {
+            ESP_LOGE(TAG, "Failed to join multicast group for universe %d: %d",
+                     universe, errno);
+            remove_subscription(sub);
+            ret = ESP_FAIL;
+        }
+    }
+    
+    ESP_LOGI(TAG, "Subscriptions updated: %d joined, %d left, %d total",
+             joined, left, sacn_state.subscription_count);
+             
+    xSemaphoreGive(sacn_state.mutex);
+    
+    return ret;
+}
+
 esp_err_t sacn_receiver_set_callback(sacn_dmx_callback_t callback, void *user_data)
 {
     if (!sacn_state.initialized) {
@@ -464,6 +672,68 @@ esp_err_t sacn_receiver_set_callback(sacn_dmx_callback_t callback, void *user_da
     return ESP_OK;
 }
 
+esp_err_t sacn_receiver_set_priority_callback(sacn_priority_callback_t callback,
+                                              void *user_data)
+{
+    if (!sacn_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    sacn_state.priority_callback = callback;
+    sacn_state.priority_callback_user_data = user_data;
+    xSemaphoreGive(sacn_state.mutex);
+    
+    ESP_LOGI(TAG, "Priority callback registered");
+    
+    return ESP_OK;
+}
+
+esp_err_t sacn_receiver_set_sync_callback(sacn_sync_callback_t callback, void *user_data)
+{
+    if (!sacn_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    sacn_state.sync_callback = callback;
+    sacn_state.sync_callback_user_data = user_data;
+    xSemaphoreGive(sacn_state.mutex);
+    
+    ESP_LOGI(TAG, "Sync callback registered");
+    
+    return ESP_OK;
+}
+
+esp_err_t sacn_receiver_set_terminate_callback(sacn_terminate_callback_t callback,
+                                               void *user_data)
+{
+    if (!sacn_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    sacn_state.terminate_callback = callback;
+    sacn_state.terminate_callback_user_data = user_data;
+    xSemaphoreGive(sacn_state.mutex);
+    
+    ESP_LOGI(TAG, "Terminate callback registered");
+    
+    return ESP_OK;
+}
+
 esp_err_t sacn_receiver_get_stats(sacn_stats_t *stats)
 {
     if (!sacn_state.initialized) {
@@ -486,7 +756,21 @@ bool sacn_receiver_is_running(void)
     return sacn_state.running;
 }
 
-uint8_t sacn_receiver_get_subscription_count(void)
+uint8_t sacn_receiver_get_source_stats(sequence_source_stats_t *sources,
+                                       uint8_t max_sources)
+{
+    if (!sacn_state.initialized || !sources) {
+        return 0;
+    }
+    
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    uint8_t count = sequence_tracker_get_sources(&sacn_state.sequence, sources, max_sources);
+    xSemaphoreGive(sacn_state.mutex);
+    
+    return count;
+}
+
+uint16_t sacn_receiver_get_subscription_count(void)
 {
     return sacn_state.subscription_count;
 }
@@ -496,52 +780,19 @@ uint8_t sacn_receiver_get_subscription_count(void)
 // ============================================================================
 
 /**
- * @brief sACN receiver task
+ * @brief Handle one datagram from the dispatcher task
  */
-static void sacn_receive_task(void *arg)
+static void sacn_handle_datagram(const uint8_t *data, size_t length,
+                                   const struct sockaddr_in *src_addr, void *user_data)
 {
-    uint8_t buffer[SACN_MAX_PACKET_SIZE];
-    struct sockaddr_in src_addr;
-    socklen_t src_addr_len = sizeof(src_addr);
-    
-    ESP_LOGI(TAG, "sACN receiver task started");
+    // Update statistics
+    sacn_state.stats.packets_received++;
     
-    while (sacn_state.running) {
-        // Receive packet
-        int len = recvfrom(sacn_state.socket_fd, buffer, sizeof(buffer), 0,
-                          (struct sockaddr *)&src_addr, &src_addr_len);
-        
-        if (len < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // Timeout, continue
-                continue;
-            }
-            
-            if (!sacn_state.running) {
-                // Socket closed, exit
-                break;
-            }
-            
-            ESP_LOGW(TAG, "Receive error: %d", errno);
-            continue;
-        }
-        
-        if (len == 0) {
-            continue;
-        }
-        
-        // Update statistics
-        sacn_state.stats.packets_received++;
-        
-        // Process packet
-        esp_err_t ret = process_sacn_packet(buffer, len, &src_addr);
-        if (ret != ESP_OK) {
-            sacn_state.stats.invalid_packets++;
-        }
+    // Process packet
+    esp_err_t ret = process_sacn_packet(data, length, src_addr);
+    if (ret != ESP_OK) {
+        sacn_state.stats.invalid_packets++;
     }
-    
-    ESP_LOGI(TAG, "sACN receiver task stopped");
-    vTaskDelete(NULL);
 }
 
 /**
@@ -550,6 +801,12 @@ static void sacn_receive_task(void *arg)
 static esp_err_t process_sacn_packet(const uint8_t *buffer, size_t length,
                                      const struct sockaddr_in *src_addr)
 {
+    // Synchronization packets have their own, shorter layout
+    if (is_sync_packet(buffer, length)) {
+        sacn_state.stats.sync_packets++;
+        return process_sacn_sync((const sacn_sync_packet_t *)buffer, src_addr);
+    }
+    
     // Validate header
     if (!validate_sacn_header(buffer, length)) {
         return ESP_FAIL;
@@ -557,13 +814,23 @@ static esp_err_t process_sacn_packet(const uint8_t *buffer, size_t length,
     
     const sacn_packet_t *packet = (const sacn_packet_t *)buffer;
     
+    // Drop universes no port outputs before touching the payload
+    if (!universe_router_is_routed(ROUTER_PROTOCOL_SACN, ntohs(packet->framing.universe))) {
+        sacn_state.stats.unrouted_packets++;
+        return ESP_OK;
+    }
+    
     // Process data packet
-    sacn_state.stats.data_packets++;
+    if (packet->dmp.start_code == SACN_START_CODE_PRIORITY) {
+        sacn_state.stats.priority_packets++;
+    } else {
+        sacn_state.stats.data_packets++;
+    }
     return process_sacn_data(packet, src_addr);
 }
 
 /**
- * @brief Process sACN data packet
+ * @brief Process sACN data packet (levels or per-address priority)
  */
 static esp_err_t process_sacn_data(const sacn_packet_t *packet,
                                    const struct sockaddr_in *src_addr)
@@ -583,32 +850,262 @@ static esp_err_t process_sacn_data(const sacn_packet_t *packet,
     // Extract sequence number
     uint8_t sequence = packet->framing.sequence_number;
     
-    // Check sequence number for this universe (optional - for statistics)
-    for (int i = 0; i < sacn_state.subscription_count; i++) {
-        if (sacn_state.subscriptions[i].universe == universe) {
-            uint8_t expected = sacn_state.subscriptions[i].last_sequence + 1;
-            if (sequence != expected && sacn_state.subscriptions[i].last_sequence != 0) {
-                sacn_state.stats.sequence_errors++;
-            }
-            sacn_state.subscriptions[i].last_sequence = sequence;
-            break;
+    // Late or repeated packets (reordered on WiFi) are discarded (E1.31 6.7.2).
+    // Priority packets are numbered on their own by some sources, so each
+    // start code is tracked separately.
+    sequence_result_t result = sequence_tracker_check(&sacn_state.sequence, packet->root.cid,
+                                                      universe, packet->dmp.start_code,
+                                                      sequence, esp_timer_get_time());
+    if (result != SEQUENCE_ACCEPT) {
+        sacn_state.stats.sequence_errors++;
+        if (result != SEQUENCE_GAP) {
+            sacn_state.stats.sequence_drops++;
+            return ESP_OK;
         }
     }
     
-    // Extract source name (null terminated)
-    char source_name[65];
-    strncpy(source_name, packet->framing.source_name, 64);
-    source_name[64] = '\0';
+    // Source name is passed in place, consumers bound it to the field size
+    const char *source_name = packet->framing.source_name;
     
     // Extract source IP address
     uint32_t source_ip = src_addr->sin_addr.s_addr;
     
+    // Stream terminated - the source is gone, its data must not be used
+    if (packet->framing.options & SACN_OPT_STREAM_TERM) {
+        sacn_state.stats.terminated_packets++;
+        sequence_tracker_forget(&sacn_state.sequence, packet->root.cid, universe);
+        drop_staged_frames(universe, packet->root.cid);
+        if (sacn_state.terminate_callback) {
+            sacn_state.terminate_callback(universe, packet->root.cid, source_ip,
+                                          sacn_state.terminate_callback_user_data);
+        }
+        return ESP_OK;
+    }
+    
+    // Per-address priority - preview streams never drive output
+    if (packet->dmp.start_code == SACN_START_CODE_PRIORITY) {
+        if (sacn_state.priority_callback && !is_preview) {
+            sacn_state.priority_callback(universe, packet->dmp.data, sequence,
+                                         source_name, packet->root.cid, source_ip,
+                                         sacn_state.priority_callback_user_data);
+        }
+        return ESP_OK;
+    }
+    
+    // Synchronized data waits for its sync packet
+    if (!is_preview && packet->framing.sync_address != 0 &&
+        stage_sync_frame(packet, source_name, source_ip)) {
+        return ESP_OK;
+    }
+    
     // Call callback if registered
     if (sacn_state.dmx_callback) {
         sacn_state.dmx_callback(universe, packet->dmp.data, priority, sequence,
-                               is_preview, source_name, source_ip,
+                               is_preview, source_name, packet->root.cid, source_ip,
                                sacn_state.dmx_callback_user_data);
     }
     
     return ESP_OK;
 }
+
+/**
+ * @brief Find the group of a sync address, optionally starting to follow it
+ * 
+ * Sync packets are sent to the sync universe's multicast group, which is
+ * joined unless the universe is already subscribed for data.
+ */
+static sync_group_t* get_sync_group(uint16_t sync_address, bool create)
+{
+    sync_group_t *free_group = NULL;
+    
+    for (int i = 0; i < SACN_MAX_SYNC_ADDRESSES; i++) {
+        sync_group_t *group = &sacn_state.sync_groups[i];
+        if (group->sync_address == sync_address) {
+            return group;
+        }
+        if (!group->sync_address && !free_group) {
+            free_group = group;
+        }
+    }
+    
+    if (!create || !free_group || sync_address > 63999) {
+        return NULL;
+    }
+    
+    // The subscription table is changed by API calls on other tasks
+    xSemaphoreTake(sacn_state.mutex, portMAX_DELAY);
+    bool subscribed = find_subscription(sync_address) != NULL;
+    xSemaphoreGive(sacn_state.mutex);
+    
+    memset(free_group, 0, sizeof(sync_group_t));
+    if (!subscribed) {
+        calculate_multicast_addr(sync_address, &free_group->mreq.imr_multiaddr);
+        free_group->mreq.imr_interface.s_addr = INADDR_ANY;
+        if (setsockopt(sacn_state.socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                      &free_group->mreq, sizeof(struct ip_mreq)) < 0) {
+            ESP_LOGW(TAG, "Failed to join sync universe %d: %d", sync_address, errno);
+            return NULL;
+        }
+        free_group->joined = true;
+    }
+    free_group->sync_address = sync_address;
+    
+    ESP_LOGI(TAG, "Following sync universe %d", sync_address);
+    
+    return free_group;
+}
+
+/**
+ * @brief Pass the frames held for a sync address to the DMX callback
+ */
+static void release_staged_frames(uint16_t sync_address)
+{
+    for (int i = 0; i < SACN_MAX_STAGED_FRAMES; i++) {
+        staged_frame_t *frame = &sacn_state.staged[i];
+        if (!frame->used || frame->sync_address != sync_address) {
+            continue;
+        }
+        
+        if (sacn_state.dmx_callback) {
+            sacn_state.dmx_callback(frame->universe, frame->data, frame->priority,
+                                   frame->sequence, false, frame->source_name,
+                                   frame->cid, frame->source_ip,
+                                   sacn_state.dmx_callback_user_data);
+        }
+        frame->used = false;
+    }
+}
+
+/**
+ * @brief Discard held frames of a source that terminated its stream
+ */
+static void drop_staged_frames(uint16_t universe, const uint8_t *cid)
+{
+    for (int i = 0; i < SACN_MAX_STAGED_FRAMES; i++) {
+        staged_frame_t *frame = &sacn_state.staged[i];
+        if (frame->used && frame->universe == universe &&
+            memcmp(frame->cid, cid, SACN_CID_LENGTH) == 0) {
+            frame->used = false;
+        }
+    }
+}
+
+/**
+ * @brief Remember a universe as synchronized by a group's address
+ */
+static void add_sync_universe(sync_group_t *group, uint16_t universe)
+{
+    for (int i = 0; i < group->universe_count; i++) {
+        if (group->universes[i] == universe) {
+            return;
+        }
+    }
+    
+    if (group->universe_count < SACN_SYNC_UNIVERSES) {
+        group->universes[group->universe_count++] = universe;
+    }
+}
+
+/**
+ * @brief Hold a data frame until its sync packet
+ * 
+ * Data is only held while sync packets for its address keep arriving; before
+ * the first one and after SACN_SYNC_TIMEOUT_MS without one it goes straight
+ * out. A newer frame of the same source (CID) and universe replaces a held one;
+ * with the staging full the frame is dropped, so one sync never mixes held
+ * and unsynchronized data.
+ * 
+ * @return true if the frame was held or dropped, false to output it now
+ */
+static bool stage_sync_frame(const sacn_packet_t *packet, const char *source_name,
+                             uint32_t source_ip)
+{
+    uint16_t sync_address = ntohs(packet->framing.sync_address);
+    uint16_t universe = ntohs(packet->framing.universe);
+    
+    sync_group_t *group = get_sync_group(sync_address, true);
+    if (!group) {
+        return false;
+    }
+    add_sync_universe(group, universe);
+    
+    if (group->synced &&
+        esp_timer_get_time() - group->last_sync_us >= SACN_SYNC_TIMEOUT_MS * 1000ULL) {
+        ESP_LOGW(TAG, "No sync on universe %d for %d ms, output unsynchronized",
+                 sync_address, SACN_SYNC_TIMEOUT_MS);
+        group->synced = false;
+        sacn_state.stats.sync_timeouts++;
+        release_staged_frames(sync_address);
+    }
+    
+    if (!group->synced) {
+        return false;
+    }
+    
+    staged_frame_t *slot = NULL;
+    for (int i = 0; i < SACN_MAX_STAGED_FRAMES; i++) {
+        staged_frame_t *frame = &sacn_state.staged[i];
+        if (frame->used && frame->universe == universe &&
+            memcmp(frame->cid, packet->root.cid, SACN_CID_LENGTH) == 0) {
+            slot = frame;
+            break;
+        }
+        if (!frame->used && !slot) {
+            slot = frame;
+        }
+    }
+    
+    // Staging full: drop the frame rather than output it ahead of the others
+    // of its sync; the source's next frame can take a freed entry
+    if (!slot) {
+        sacn_state.stats.staged_drops++;
+        return true;
+    }
+    
+    slot->used = true;
+    slot->sync_address = sync_address;
+    slot->universe = universe;
+    slot->priority = packet->framing.priority;
+    slot->sequence = packet->framing.sequence_number;
+    slot->source_ip = source_ip;
+    memcpy(slot->cid, packet->root.cid, SACN_CID_LENGTH);
+    memcpy(slot->source_name, source_name, SACN_SOURCE_NAME_LENGTH);
+    memcpy(slot->data, packet->dmp.data, sizeof(slot->data));
+    sacn_state.stats.staged_frames++;
+    
+    return true;
+}
+
+/**
+ * @brief Process sACN synchronization packet
+ */
+static esp_err_t process_sacn_sync(const sacn_sync_packet_t *packet,
+                                   const struct sockaddr_in *src_addr)
+{
+    uint16_t sync_address = ntohs(packet->framing.sync_address);
+    
+    if (sync_address == 0) {
+        return ESP_OK;
+    }
+    
+    // Only addresses announced by data packets are followed
+    sync_group_t *group = get_sync_group(sync_address, false);
+    if (!group) {
+        return ESP_OK;
+    }
+    
+    if (!group->synced) {
+        ESP_LOGI(TAG, "Synchronized output on sync universe %d", sync_address);
+    }
+    group->synced = true;
+    group->last_sync_us = esp_timer_get_time();
+    
+    release_staged_frames(sync_address);
+    
+    if (sacn_state.sync_callback) {
+        sacn_state.sync_callback(sync_address, group->universes, group->universe_count,
+                                 src_addr->sin_addr.s_addr, sacn_state.sync_callback_user_data);
+    }
+    
+    return ESP_OK;
+}
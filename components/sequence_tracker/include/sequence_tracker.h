@@ -0,0 +1,143 @@
+#ifndef SEQUENCE_TRACKER_H
+#define SEQUENCE_TRACKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sequence Tracker Module
+ * 
+ * Tracks the last sequence number of every (source, universe) stream and
+ * rejects packets that arrive late or twice, so reordered frames never
+ * reach the merge engine.
+ * 
+ * Features:
+ * - E1.31 rule (section 6.7.2): discard if -20 < (new - last) <= 0
+ * - The same window for Art-Net, whose counter runs 1..255 and where 0
+ *   means sequencing is disabled
+ * - A stream that has been silent for the timeout starts over
+ * - Compact open-addressed hash, the stalest entry is reused when full
+ * - Per-stream reordered / duplicated / lost counters
+ * 
+ * A tracker is owned by one receive task and needs no locking there.
+ * Readers of the counters on other tasks may see a stream that is being
+ * replaced at that moment.
+ */
+
+// Table limits
+#define SEQUENCE_TRACKER_SIZE      32  // Streams tracked (power of two)
+#define SEQUENCE_SOURCE_ID_LENGTH  16  // sACN CID, or Art-Net IP in the first 4 bytes
+
+// Packets this far behind the last one are late, not a restarted source
+#define SEQUENCE_WINDOW 20
+
+/**
+ * @brief Sequence numbering scheme
+ */
+typedef enum {
+    SEQUENCE_MODE_E131 = 0,        /**< 0..255, wraps to 0 */
+    SEQUENCE_MODE_ARTNET           /**< 1..255, wraps to 1; 0 = disabled */
+} sequence_mode_t;
+
+/**
+ * @brief Result of a sequence check
+ */
+typedef enum {
+    SEQUENCE_ACCEPT = 0,           /**< In order */
+    SEQUENCE_GAP,                  /**< Accepted, packets were skipped */
+    SEQUENCE_DUPLICATE,            /**< Discard: same number as the last one */
+    SEQUENCE_LATE                  /**< Discard: older than the last one */
+} sequence_result_t;
+
+/**
+ * @brief Counters of one stream
+ */
+typedef struct {
+    uint8_t source_id[SEQUENCE_SOURCE_ID_LENGTH]; /**< CID, or IP (network byte order) */
+    uint16_t universe;             /**< Universe of the stream */
+    uint8_t stream;                /**< Sub-stream (sACN start code) */
+    uint32_t reordered;            /**< Late packets discarded */
+    uint32_t duplicated;           /**< Repeated packets discarded */
+    uint32_t lost;                 /**< Packets skipped by forward jumps */
+} sequence_source_stats_t;
+
+/**
+ * @brief Hash table entry (internal)
+ */
+typedef struct {
+    bool used;
+    bool active;                   // false = next packet starts over
+    uint8_t last_sequence;
+    int64_t last_seen_us;
+    sequence_source_stats_t stats;
+} sequence_entry_t;
+
+/**
+ * @brief Sequence tracker, embedded in the owning receiver's state
+ */
+typedef struct {
+    sequence_mode_t mode;
+    int64_t timeout_us;
+    sequence_entry_t entries[SEQUENCE_TRACKER_SIZE];
+} sequence_tracker_t;
+
+/**
+ * @brief Initialize a tracker
+ * 
+ * @param tracker Tracker to initialize
+ * @param mode Sequence numbering scheme of the protocol
+ * @param timeout_ms Silence after which a stream starts over
+ */
+void sequence_tracker_init(sequence_tracker_t *tracker, sequence_mode_t mode,
+                           uint32_t timeout_ms);
+
+/**
+ * @brief Check a packet's sequence number and record it
+ * 
+ * @param tracker Tracker
+ * @param source_id Source identity (SEQUENCE_SOURCE_ID_LENGTH bytes)
+ * @param universe Universe of the packet
+ * @param stream Sub-stream with its own numbering (sACN start code, else 0)
+ * @param sequence Sequence number of the packet
+ * @param now_us Current time in microseconds
+ * @return SEQUENCE_ACCEPT or SEQUENCE_GAP to use the packet, otherwise
+ *         the reason it must be discarded
+ */
+sequence_result_t sequence_tracker_check(sequence_tracker_t *tracker,
+                                         const uint8_t *source_id, uint16_t universe,
+                                         uint8_t stream, uint8_t sequence, int64_t now_us);
+
+/**
+ * @brief Forget the sequence state of a source on one universe
+ * 
+ * Used when a source ends its stream, so its next packet starts over.
+ * The counters are kept.
+ * 
+ * @param tracker Tracker
+ * @param source_id Source identity (SEQUENCE_SOURCE_ID_LENGTH bytes)
+ * @param universe Universe
+ */
+void sequence_tracker_forget(sequence_tracker_t *tracker, const uint8_t *source_id,
+                             uint16_t universe);
+
+/**
+ * @brief Copy the counters of the tracked streams
+ * 
+ * @param tracker Tracker
+ * @param sources Output array
+ * @param max_sources Size of output array
+ * @return Number of streams written
+ */
+uint8_t sequence_tracker_get_sources(const sequence_tracker_t *tracker,
+                                     sequence_source_stats_t *sources,
+                                     uint8_t max_sources);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SEQUENCE_TRACKER_H
@@ -0,0 +1,171 @@
+/**
+ * @file sequence_tracker.c
+ * @brief Per-source sequence window implementation
+ * 
+ * Entries are never removed, only reused, so probe chains stay intact and
+ * lookups need no tombstones. A new stream takes the first free entry of
+ * its probe window, or the one that was seen least recently.
+ * 
+ * Memory Usage:
+ * - ~1.5KB per tracker
+ */
+
+#include "sequence_tracker.h"
+#include <string.h>
+
+// Entries looked at per lookup
+#define SEQUENCE_TRACKER_PROBES 8
+
+/**
+ * @brief Hash a stream key to a table index (FNV-1a)
+ */
+static uint32_t stream_hash(const uint8_t *source_id, uint16_t universe, uint8_t stream)
+{
+    uint32_t hash = 2166136261u;
+    
+    for (int i = 0; i < SEQUENCE_SOURCE_ID_LENGTH; i++) {
+        hash = (hash ^ source_id[i]) * 16777619u;
+    }
+    hash = (hash ^ (universe & 0xFF)) * 16777619u;
+    hash = (hash ^ (universe >> 8)) * 16777619u;
+    hash = (hash ^ stream) * 16777619u;
+    
+    return hash & (SEQUENCE_TRACKER_SIZE - 1);
+}
+
+/**
+ * @brief Whether an entry holds a stream key
+ */
+static inline bool entry_matches(const sequence_entry_t *entry, const uint8_t *source_id,
+                                 uint16_t universe, uint8_t stream)
+{
+    return entry->stats.universe == universe && entry->stats.stream == stream &&
+           memcmp(entry->stats.source_id, source_id, SEQUENCE_SOURCE_ID_LENGTH) == 0;
+}
+
+/**
+ * @brief Find the entry of a stream, claiming one if it is new
+ */
+static sequence_entry_t* find_entry(sequence_tracker_t *tracker, const uint8_t *source_id,
+                                    uint16_t universe, uint8_t stream)
+{
+    uint32_t index = stream_hash(source_id, universe, stream);
+    sequence_entry_t *victim = NULL;
+    
+    for (int probe = 0; probe < SEQUENCE_TRACKER_PROBES; probe++) {
+        sequence_entry_t *entry = &tracker->entries[(index + probe) & (SEQUENCE_TRACKER_SIZE - 1)];
+        if (!entry->used) {
+            victim = entry;
+            break;
+        }
+        if (entry_matches(entry, source_id, universe, stream)) {
+            return entry;
+        }
+        if (!victim || entry->last_seen_us < victim->last_seen_us) {
+            victim = entry;
+        }
+    }
+    
+    // New stream: take the free entry or evict the stalest one
+    memset(victim, 0, sizeof(sequence_entry_t));
+    victim->used = true;
+    memcpy(victim->stats.source_id, source_id, SEQUENCE_SOURCE_ID_LENGTH);
+    victim->stats.universe = universe;
+    victim->stats.stream = stream;
+    
+    return victim;
+}
+
+/**
+ * @brief Signed distance from the last sequence number to a new one
+ */
+static int sequence_distance(sequence_mode_t mode, uint8_t last, uint8_t sequence)
+{
+    if (mode == SEQUENCE_MODE_E131) {
+        return (int8_t)(uint8_t)(sequence - last);
+    }
+    
+    // Art-Net counts 1..255, so the numbers wrap modulo 255
+    int diff = (int)sequence - (int)last;
+    if (diff > 127) {
+        diff -= 255;
+    } else if (diff < -127) {
+        diff += 255;
+    }
+    
+    return diff;
+}
+
+void sequence_tracker_init(sequence_tracker_t *tracker, sequence_mode_t mode,
+                           uint32_t timeout_ms)
+{
+    memset(tracker, 0, sizeof(sequence_tracker_t));
+    tracker->mode = mode;
+    tracker->timeout_us = (int64_t)timeout_ms * 1000;
+}
+
+sequence_result_t sequence_tracker_check(sequence_tracker_t *tracker,
+                                         const uint8_t *source_id, uint16_t universe,
+                                         uint8_t stream, uint8_t sequence, int64_t now_us)
+{
+    // Art-Net senders that do not number their packets send 0
+    if (tracker->mode == SEQUENCE_MODE_ARTNET && sequence == 0) {
+        return SEQUENCE_ACCEPT;
+    }
+    
+    sequence_entry_t *entry = find_entry(tracker, source_id, universe, stream);
+    sequence_result_t result = SEQUENCE_ACCEPT;
+    
+    if (entry->active && now_us - entry->last_seen_us < tracker->timeout_us) {
+        int diff = sequence_distance(tracker->mode, entry->last_sequence, sequence);
+        
+        if (diff <= 0 && diff > -SEQUENCE_WINDOW) {
+            if (diff == 0) {
+                entry->stats.duplicated++;
+                return SEQUENCE_DUPLICATE;
+            }
+            entry->stats.reordered++;
+            return SEQUENCE_LATE;
+        }
+        
+        // Further back than the window: the source restarted its count
+        if (diff > 1) {
+            entry->stats.lost += diff - 1;
+            result = SEQUENCE_GAP;
+        }
+    }
+    
+    entry->active = true;
+    entry->last_sequence = sequence;
+    entry->last_seen_us = now_us;
+    
+    return result;
+}
+
+void sequence_tracker_forget(sequence_tracker_t *tracker, const uint8_t *source_id,
+                             uint16_t universe)
+{
+    // Rare (stream termination), so every sub-stream is found by a full scan
+    for (int i = 0; i < SEQUENCE_TRACKER_SIZE; i++) {
+        sequence_entry_t *entry = &tracker->entries[i];
+        if (entry->used && entry->stats.universe == universe &&
+            memcmp(entry->stats.source_id, source_id, SEQUENCE_SOURCE_ID_LENGTH) == 0) {
+            entry->active = false;
+        }
+    }
+}
+
+uint8_t sequence_tracker_get_sources(const sequence_tracker_t *tracker,
+                                     sequence_source_stats_t *sources,
+                                     uint8_t max_sources)
+{
+    uint8_t count = 0;
+    
+    for (int i = 0; i < SEQUENCE_TRACKER_SIZE && count < max_sources; i++) {
+        if (tracker->entries[i].used) {
+            sources[count++] = tracker->entries[i].stats;
+        }
+    }
+    
+    return count;
+}
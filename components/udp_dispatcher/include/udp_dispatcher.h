@@ -0,0 +1,133 @@
+#ifndef UDP_DISPATCHER_H
+#define UDP_DISPATCHER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lwip/sockets.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UDP Receive Dispatcher Module
+ * 
+ * One task receives for every protocol socket (Art-Net, sACN). It waits on
+ * all of them with select() and, on each wakeup, drains every queued
+ * datagram of a readable socket into a pool of preallocated buffers before
+ * handing them to the protocol's handler by pointer. A burst of universes
+ * thus costs one task switch instead of one per packet, and the lwIP
+ * mailbox is emptied before it can overflow.
+ * 
+ * Features:
+ * - Single receive task multiplexing all registered sockets
+ * - Batched non-blocking receive into a static buffer pool
+ * - No periodic wakeups: registration changes wake the task through a
+ *   loopback control socket
+ * - Queue-depth and drop counters
+ */
+
+// Limits
+#define UDP_DISPATCHER_MAX_SOCKETS  4
+#define UDP_DISPATCHER_POOL_SIZE    8     // Datagrams received per batch
+#define UDP_DISPATCHER_BUFFER_SIZE  1024  // Larger than any packet handled
+
+/**
+ * @brief Datagram handler
+ * 
+ * Called from the dispatcher task. The buffer is only valid during the call.
+ * 
+ * @param data Datagram payload
+ * @param length Payload length
+ * @param src_addr Sender address
+ * @param user_data User data pointer
+ */
+typedef void (*udp_dispatcher_handler_t)(const uint8_t *data, size_t length,
+                                         const struct sockaddr_in *src_addr,
+                                         void *user_data);
+
+/**
+ * @brief Dispatcher statistics
+ */
+typedef struct {
+    uint32_t wakeups;              /**< select() returns */
+    uint32_t datagrams;            /**< Datagrams handed to handlers */
+    uint32_t batches;              /**< Batches received */
+    uint32_t queue_depth_max;      /**< Most datagrams drained from one socket in one wakeup */
+    uint32_t pool_full;            /**< Batches that filled the buffer pool (backlog) */
+    uint32_t truncated_drops;      /**< Datagrams too large for a buffer, dropped */
+    uint32_t receive_errors;       /**< Receive errors other than an empty queue */
+} udp_dispatcher_stats_t;
+
+/**
+ * @brief Initialize the dispatcher and start its task
+ * 
+ * Requires the network stack (esp_netif) to be initialized.
+ * 
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if already initialized
+ *     - ESP_ERR_NO_MEM if memory allocation failed
+ *     - ESP_FAIL if the control socket or task could not be created
+ */
+esp_err_t udp_dispatcher_init(void);
+
+/**
+ * @brief Stop the dispatcher task
+ * 
+ * Registered sockets are closed.
+ * 
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t udp_dispatcher_deinit(void);
+
+/**
+ * @brief Start receiving on a bound UDP socket
+ * 
+ * @param socket_fd Bound socket
+ * @param handler Handler for its datagrams
+ * @param user_data User data passed to the handler
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if parameters invalid
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NO_MEM if UDP_DISPATCHER_MAX_SOCKETS are registered
+ */
+esp_err_t udp_dispatcher_register(int socket_fd, udp_dispatcher_handler_t handler,
+                                  void *user_data);
+
+/**
+ * @brief Stop receiving on a socket and close it
+ * 
+ * The dispatcher task closes the socket once it no longer waits on it, so
+ * the caller must not close it. No new handler call starts after this
+ * returns; one already in progress on the dispatcher task completes.
+ * 
+ * @param socket_fd Registered socket
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NOT_FOUND if the socket is not registered
+ */
+esp_err_t udp_dispatcher_unregister(int socket_fd);
+
+/**
+ * @brief Get dispatcher statistics
+ * 
+ * @param stats Pointer to statistics structure
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if stats is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t udp_dispatcher_get_stats(udp_dispatcher_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UDP_DISPATCHER_H
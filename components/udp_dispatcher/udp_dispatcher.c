@@ -0,0 +1,424 @@
+/**
+ * @file udp_dispatcher.c
+ * @brief UDP Receive Dispatcher Implementation
+ * 
+ * The task rebuilds its select() set on every wakeup from the socket table.
+ * Registration changes are made under the mutex and announced with one byte
+ * on a loopback control socket, so select() needs no timeout. Unregistered
+ * sockets are closed by the task itself, after it has stopped waiting on
+ * them; closing a socket another task is blocked on is not safe in lwIP.
+ * 
+ * Thread Safety:
+ * - Public APIs are serialized by a mutex
+ * - Handlers run on the dispatcher task without the mutex held, so they may
+ *   call back into their own module
+ * 
+ * Memory Usage:
+ * - ~8KB buffer pool
+ * - Task stack: 6KB
+ * - Total: ~14KB (replaces two 4KB receive tasks and their stack buffers)
+ */
+
+#include "udp_dispatcher.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+
+static const char *TAG = "udp_dispatcher";
+
+// Task configuration
+#define UDP_DISPATCHER_TASK_STACK_SIZE 6144
+#define UDP_DISPATCHER_TASK_PRIORITY   5
+#define UDP_DISPATCHER_TASK_CORE       0
+
+/**
+ * @brief Socket table entry state
+ */
+typedef enum {
+    ENTRY_FREE = 0,
+    ENTRY_ACTIVE,                  // Watched by the task
+    ENTRY_CLOSING                  // Unregistered, the task closes it
+} entry_state_t;
+
+/**
+ * @brief Registered socket
+ */
+typedef struct {
+    atomic_int state;
+    int socket_fd;
+    udp_dispatcher_handler_t handler;
+    void *user_data;
+} socket_entry_t;
+
+/**
+ * @brief Pool buffer: one received datagram
+ */
+typedef struct {
+    size_t length;
+    struct sockaddr_in src_addr;
+    uint8_t data[UDP_DISPATCHER_BUFFER_SIZE];
+} packet_buffer_t;
+
+/**
+ * @brief Module state
+ */
+static struct {
+    bool initialized;
+    atomic_bool running;
+    
+    int ctrl_fd;                   // Loopback socket that wakes the task
+    struct sockaddr_in ctrl_addr;
+    TaskHandle_t task_handle;
+    
+    socket_entry_t sockets[UDP_DISPATCHER_MAX_SOCKETS];
+    packet_buffer_t pool[UDP_DISPATCHER_POOL_SIZE];  // Dispatcher task only
+    
+    udp_dispatcher_stats_t stats;
+    
+    SemaphoreHandle_t mutex;
+} dispatcher_state = {
+    .initialized = false,
+    .ctrl_fd = -1,
+};
+
+// Forward declarations
+static void dispatcher_task(void *arg);
+
+/**
+ * @brief Wake the task so it rebuilds its socket set
+ */
+static void wake_task(void)
+{
+    uint8_t byte = 0;
+    sendto(dispatcher_state.ctrl_fd, &byte, sizeof(byte), 0,
+           (const struct sockaddr *)&dispatcher_state.ctrl_addr,
+           sizeof(dispatcher_state.ctrl_addr));
+}
+
+/**
+ * @brief Create the loopback control socket
+ */
+static bool create_ctrl_socket(void)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = 0,             // Any free port
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK)
+    };
+    socklen_t addr_len = sizeof(addr);
+    
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) < 0) {
+        close(fd);
+        return false;
+    }
+    
+    dispatcher_state.ctrl_fd = fd;
+    dispatcher_state.ctrl_addr = addr;
+    
+    return true;
+}
+
+/**
+ * @brief Receive every queued datagram of a socket and dispatch them
+ * 
+ * Datagrams are received in batches of up to UDP_DISPATCHER_POOL_SIZE; a
+ * full batch means more may be queued, so the socket is read again.
+ */
+static void drain_socket(socket_entry_t *entry)
+{
+    uint32_t drained = 0;
+    int count;
+    
+    do {
+        count = 0;
+        while (count < UDP_DISPATCHER_POOL_SIZE) {
+            packet_buffer_t *buffer = &dispatcher_state.pool[count];
+            socklen_t addr_len = sizeof(buffer->src_addr);
+            int len = recvfrom(entry->socket_fd, buffer->data, sizeof(buffer->data),
+                               MSG_DONTWAIT, (struct sockaddr *)&buffer->src_addr,
+                               &addr_len);
+            if (len < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    dispatcher_state.stats.receive_errors++;
+                }
+                break;
+            }
+            
+            // lwIP silently truncates; a full buffer may have been cut short
+            if (len == 0 || len >= (int)sizeof(buffer->data)) {
+                if (len) {
+                    dispatcher_state.stats.truncated_drops++;
+                }
+                continue;
+            }
+            
+            buffer->length = len;
+            count++;
+        }
+        
+        if (count == 0) {
+            break;
+        }
+        
+        dispatcher_state.stats.batches++;
+        if (count == UDP_DISPATCHER_POOL_SIZE) {
+            dispatcher_state.stats.pool_full++;
+        }
+        drained += count;
+        
+        for (int i = 0; i < count; i++) {
+            // Stop as soon as the owner unregisters
+            if (atomic_load(&entry->state) != ENTRY_ACTIVE) {
+                return;
+            }
+            const packet_buffer_t *buffer = &dispatcher_state.pool[i];
+            entry->handler(buffer->data, buffer->length, &buffer->src_addr, entry->user_data);
+            dispatcher_state.stats.datagrams++;
+        }
+    } while (count == UDP_DISPATCHER_POOL_SIZE);
+    
+    if (drained > dispatcher_state.stats.queue_depth_max) {
+        dispatcher_state.stats.queue_depth_max = drained;
+    }
+}
+
+/**
+ * @brief Dispatcher task
+ */
+static void dispatcher_task(void *arg)
+{
+    ESP_LOGI(TAG, "Dispatcher task started");
+    
+    while (atomic_load(&dispatcher_state.running)) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(dispatcher_state.ctrl_fd, &readable);
+        int max_fd = dispatcher_state.ctrl_fd;
+        
+        // Close what was unregistered, watch the rest
+        xSemaphoreTake(dispatcher_state.mutex, portMAX_DELAY);
+        for (int i = 0; i < UDP_DISPATCHER_MAX_SOCKETS; i++) {
+            socket_entry_t *entry = &dispatcher_state.sockets[i];
+            int state = atomic_load(&entry->state);
+            if (state == ENTRY_CLOSING) {
+                close(entry->socket_fd);
+                atomic_store(&entry->state, ENTRY_FREE);
+            } else if (state == ENTRY_ACTIVE) {
+                FD_SET(entry->socket_fd, &readable);
+                if (entry->socket_fd > max_fd) {
+                    max_fd = entry->socket_fd;
+                }
+            }
+        }
+        xSemaphoreGive(dispatcher_state.mutex);
+        
+        int ready = select(max_fd + 1, &readable, NULL, NULL, NULL);
+        if (ready < 0) {
+            ESP_LOGW(TAG, "select failed: %d", errno);
+            dispatcher_state.stats.receive_errors++;
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        dispatcher_state.stats.wakeups++;
+        
+        // Entries are only freed by this task, so they stay valid here
+        for (int i = 0; i < UDP_DISPATCHER_MAX_SOCKETS; i++) {
+            socket_entry_t *entry = &dispatcher_state.sockets[i];
+            if (atomic_load(&entry->state) == ENTRY_ACTIVE &&
+                FD_ISSET(entry->socket_fd, &readable)) {
+                drain_socket(entry);
+            }
+        }
+        
+        if (FD_ISSET(dispatcher_state.ctrl_fd, &readable)) {
+            uint8_t byte;
+            while (recv(dispatcher_state.ctrl_fd, &byte, sizeof(byte), MSG_DONTWAIT) > 0) {
+            }
+        }
+    }
+    
+    ESP_LOGI(TAG, "Dispatcher task stopped");
+    dispatcher_state.task_handle = NULL;
+    vTaskDelete(NULL);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+esp_err_t udp_dispatcher_init(void)
+{
+    if (dispatcher_state.initialized) {
+        ESP_LOGW(TAG, "Already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    dispatcher_state.mutex = xSemaphoreCreateMutex();
+    if (!dispatcher_state.mutex) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (!create_ctrl_socket()) {
+        ESP_LOGE(TAG, "Failed to create control socket: %d", errno);
+        vSemaphoreDelete(dispatcher_state.mutex);
+        dispatcher_state.mutex = NULL;
+        return ESP_FAIL;
+    }
+    
+    memset(dispatcher_state.sockets, 0, sizeof(dispatcher_state.sockets));
+    memset(&dispatcher_state.stats, 0, sizeof(udp_dispatcher_stats_t));
+    atomic_store(&dispatcher_state.running, true);
+    
+    BaseType_t ret = xTaskCreatePinnedToCore(
+        dispatcher_task,
+        "udp_rx",
+        UDP_DISPATCHER_TASK_STACK_SIZE,
+        NULL,
+        UDP_DISPATCHER_TASK_PRIORITY,
+        &dispatcher_state.task_handle,
+        UDP_DISPATCHER_TASK_CORE
+    );
+    
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create dispatcher task");
+        atomic_store(&dispatcher_state.running, false);
+        close(dispatcher_state.ctrl_fd);
+        dispatcher_state.ctrl_fd = -1;
+        vSemaphoreDelete(dispatcher_state.mutex);
+        dispatcher_state.mutex = NULL;
+        return ESP_FAIL;
+    }
+    
+    dispatcher_state.initialized = true;
+    ESP_LOGI(TAG, "UDP dispatcher initialized");
+    
+    return ESP_OK;
+}
+
+esp_err_t udp_dispatcher_deinit(void)
+{
+    if (!dispatcher_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    atomic_store(&dispatcher_state.running, false);
+    wake_task();
+    
+    // Wait for task to terminate
+    while (dispatcher_state.task_handle) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
+    for (int i = 0; i < UDP_DISPATCHER_MAX_SOCKETS; i++) {
+        socket_entry_t *entry = &dispatcher_state.sockets[i];
+        if (atomic_load(&entry->state) != ENTRY_FREE) {
+            close(entry->socket_fd);
+            atomic_store(&entry->state, ENTRY_FREE);
+        }
+    }
+    
+    close(dispatcher_state.ctrl_fd);
+    dispatcher_state.ctrl_fd = -1;
+    
+    vSemaphoreDelete(dispatcher_state.mutex);
+    dispatcher_state.mutex = NULL;
+    
+    dispatcher_state.initialized = false;
+    ESP_LOGI(TAG, "UDP dispatcher deinitialized");
+    
+    return ESP_OK;
+}
+
+esp_err_t udp_dispatcher_register(int socket_fd, udp_dispatcher_handler_t handler,
+                                  void *user_data)
+{
+    if (!dispatcher_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (socket_fd < 0 || !handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(dispatcher_state.mutex, portMAX_DELAY);
+    
+    socket_entry_t *entry = NULL;
+    for (int i = 0; i < UDP_DISPATCHER_MAX_SOCKETS; i++) {
+        if (atomic_load(&dispatcher_state.sockets[i].state) == ENTRY_FREE) {
+            entry = &dispatcher_state.sockets[i];
+            break;
+        }
+    }
+    
+    if (!entry) {
+        ESP_LOGE(TAG, "Maximum sockets reached");
+        xSemaphoreGive(dispatcher_state.mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    entry->socket_fd = socket_fd;
+    entry->handler = handler;
+    entry->user_data = user_data;
+    atomic_store(&entry->state, ENTRY_ACTIVE);
+    
+    xSemaphoreGive(dispatcher_state.mutex);
+    
+    wake_task();
+    
+    return ESP_OK;
+}
+
+esp_err_t udp_dispatcher_unregister(int socket_fd)
+{
+    if (!dispatcher_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    xSemaphoreTake(dispatcher_state.mutex, portMAX_DELAY);
+    
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    for (int i = 0; i < UDP_DISPATCHER_MAX_SOCKETS; i++) {
+        socket_entry_t *entry = &dispatcher_state.sockets[i];
+        if (atomic_load(&entry->state) == ENTRY_ACTIVE && entry->socket_fd == socket_fd) {
+            atomic_store(&entry->state, ENTRY_CLOSING);
+            ret = ESP_OK;
+            break;
+        }
+    }
+    
+    xSemaphoreGive(dispatcher_state.mutex);
+    
+    if (ret == ESP_OK) {
+        wake_task();
+    }
+    
+    return ret;
+}
+
+esp_err_t udp_dispatcher_get_stats(udp_dispatcher_stats_t *stats)
+{
+    if (!dispatcher_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(dispatcher_state.mutex, portMAX_DELAY);
+    memcpy(stats, &dispatcher_state.stats, sizeof(udp_dispatcher_stats_t));
+    xSemaphoreGive(dispatcher_state.mutex);
+    
+    return ESP_OK;
+}
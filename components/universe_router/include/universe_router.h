@@ -0,0 +1,188 @@
+#ifndef UNIVERSE_ROUTER_H
+#define UNIVERSE_ROUTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "config_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Universe Router Module
+ * 
+ * Maps each incoming (protocol, universe) to the merge that takes it, and
+ * each DMX port to the merges it outputs. The table is built from config and
+ * consulted by the receivers right after the header check, so packets for
+ * universes this node does not output are dropped before their payload is
+ * touched.
+ * 
+ * Features:
+ * - Art-Net 15-bit Port-Address and sACN universe keys
+ * - O(1) lookup (small open-addressed hash), lock-free for readers
+ * - One merge per (protocol, universe): a universe is pushed and merged once
+ *   however many ports output it
+ * - Primary and secondary universe per port; each port reads the merges of
+ *   its universes, the secondary shifted by the port's universe_offset
+ * - Tables sized from the port count (CONFIG_DMX_PORT_COUNT)
+ * - Double-buffered table: a rebuild never blocks the receive path
+ */
+
+// Table limits
+#define UNIVERSE_ROUTER_PORTS          CONFIG_DMX_PORT_COUNT // DMX ports
+#define UNIVERSE_ROUTER_PORT_UNIVERSES 2 // Universes one port outputs (primary, secondary)
+
+// Merges one port reads: each of its universes over both protocols
+#define UNIVERSE_ROUTER_PORT_MERGES (UNIVERSE_ROUTER_PORT_UNIVERSES * 2)
+
+// Distinct (protocol, universe) keys, one merge each
+#define UNIVERSE_ROUTER_MAX_ROUTES (UNIVERSE_ROUTER_PORTS * UNIVERSE_ROUTER_PORT_MERGES)
+
+/**
+ * @brief Protocol a universe number belongs to
+ */
+typedef enum {
+    ROUTER_PROTOCOL_ARTNET = 0,
+    ROUTER_PROTOCOL_SACN
+} router_protocol_t;
+
+/**
+ * @brief One merge a port outputs
+ */
+typedef struct {
+    uint8_t merge;               /**< Merge of the universe (1..UNIVERSE_ROUTER_MAX_ROUTES) */
+    int16_t offset;              /**< Channel offset of the universe on the port */
+} universe_route_t;
+
+/**
+ * @brief The universe behind a merge
+ */
+typedef struct {
+    router_protocol_t protocol;  /**< Protocol of the universe number */
+    uint16_t universe;           /**< Normalized universe (Art-Net: 15-bit Port-Address) */
+    uint8_t port;                /**< First port outputting it; its merge settings apply */
+    int16_t offset;              /**< Channel offset of the universe on that port */
+} universe_merge_info_t;
+
+/**
+ * @brief Initialize universe router
+ * 
+ * Starts with an empty table (every universe is dropped).
+ * 
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_NO_MEM if memory allocation failed
+ *     - ESP_ERR_INVALID_STATE if already initialized
+ */
+esp_err_t universe_router_init(void);
+
+/**
+ * @brief Rebuild the routing table from configuration
+ * 
+ * Gives each (protocol, universe) a port outputs one merge, numbered from 1
+ * in port order: the port's primary universe (offset 0), then its secondary
+ * (offset universe_offset), for the protocols its protocol_mode accepts.
+ * Ports outputting the same universe share its merge, which takes the merge
+ * settings of the first of them (see universe_router_get_merge). The new
+ * table replaces the old one atomically.
+ * 
+ * @param config Configuration to build from
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if config is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NO_MEM if the table is full
+ */
+esp_err_t universe_router_build(const config_t *config);
+
+/**
+ * @brief Check whether a universe is routed to a merge
+ * 
+ * Lock-free; safe to call from the receive tasks for every packet.
+ * 
+ * @param protocol Protocol of the universe number
+ * @param universe Art-Net Port-Address or sACN universe
+ * @return true if a port outputs this universe
+ */
+bool universe_router_is_routed(router_protocol_t protocol, uint16_t universe);
+
+/**
+ * @brief Look up the merge of a universe
+ * 
+ * Lock-free; safe to call from the receive tasks for every packet.
+ * 
+ * @param protocol Protocol of the universe number
+ * @param universe Art-Net Port-Address or sACN universe
+ * @return Merge number, 0 if not routed
+ */
+uint8_t universe_router_lookup(router_protocol_t protocol, uint16_t universe);
+
+/**
+ * @brief Get the number of merges the table uses
+ * 
+ * @return Merges numbered 1..count
+ */
+uint8_t universe_router_get_merge_count(void);
+
+/**
+ * @brief Get the universe behind a merge
+ * 
+ * @param merge Merge number (1..universe_router_get_merge_count())
+ * @param info Output universe and the port whose settings apply
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if info is NULL
+ *     - ESP_ERR_INVALID_STATE if not initialized
+ *     - ESP_ERR_NOT_FOUND if the merge is not in use
+ */
+esp_err_t universe_router_get_merge(uint8_t merge, universe_merge_info_t *info);
+
+/**
+ * @brief List the merges a port outputs
+ * 
+ * Primary universe first, then the secondary; for each, the protocol the
+ * port's protocol_mode prefers comes first.
+ * 
+ * @param port DMX port (1..UNIVERSE_ROUTER_PORTS)
+ * @param routes Output array (UNIVERSE_ROUTER_PORT_MERGES is enough)
+ * @param max_routes Size of output array
+ * @return Number of merges written
+ */
+uint8_t universe_router_get_port_routes(uint8_t port, universe_route_t *routes,
+                                        uint8_t max_routes);
+
+/**
+ * @brief List the routed universes of one protocol
+ * 
+ * Used to join the sACN multicast groups the table needs.
+ * 
+ * @param protocol Protocol to list
+ * @param universes Output array
+ * @param max_universes Size of output array
+ * @return Number of universes written
+ */
+uint8_t universe_router_get_universes(router_protocol_t protocol, uint16_t *universes,
+                                      uint8_t max_universes);
+
+/**
+ * @brief List the universes a port outputs for one protocol
+ * 
+ * Used to announce the port, e.g. its Art-Net Port-Addresses in
+ * ArtPollReply. The primary universe comes first, then the secondary.
+ * 
+ * @param protocol Protocol of the universe numbers
+ * @param port DMX port (1..UNIVERSE_ROUTER_PORTS)
+ * @param universes Output array of normalized universes (Art-Net: 15-bit Port-Address)
+ * @param max_universes Size of output array (UNIVERSE_ROUTER_PORT_UNIVERSES is enough)
+ * @return Number of universes written
+ */
+uint8_t universe_router_get_port_universes(router_protocol_t protocol, uint8_t port,
+                                           uint16_t *universes, uint8_t max_universes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UNIVERSE_ROUTER_H
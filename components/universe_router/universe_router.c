@@ -0,0 +1,472 @@
+/**
+ * @file universe_router.c
+ * @brief Universe Routing Table Implementation
+ * 
+ * Thread Safety:
+ * - Lookups are lock-free and run on the receive tasks
+ * - Rebuilds are serialized by a mutex and fill the inactive table, which is
+ *   then published with one atomic store. A lookup racing two back-to-back
+ *   rebuilds may see a mix of both; rebuilds only follow config changes.
+ * 
+ * Memory Usage:
+ * - 2 tables x 16 entries plus the port routes, under 0.5KB
+ */
+
+#include "universe_router.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <stdatomic.h>
+
+static const char *TAG = "universe_router";
+
+// Hash table size: the smallest power of two at least twice the route limit
+// (which follows the port count), so the table stays half empty and probes short
+#if 2 * UNIVERSE_ROUTER_MAX_ROUTES <= 16
+#define ROUTER_TABLE_BITS 4
+#elif 2 * UNIVERSE_ROUTER_MAX_ROUTES <= 32
+#define ROUTER_TABLE_BITS 5
+#elif 2 * UNIVERSE_ROUTER_MAX_ROUTES <= 64
+#define ROUTER_TABLE_BITS 6
+#elif 2 * UNIVERSE_ROUTER_MAX_ROUTES <= 128
+#define ROUTER_TABLE_BITS 7
+#elif 2 * UNIVERSE_ROUTER_MAX_ROUTES <= 256
+#define ROUTER_TABLE_BITS 8
+#else
+#error "UNIVERSE_ROUTER_MAX_ROUTES too large, merge numbers are 8-bit"
+#endif
+#define ROUTER_TABLE_SIZE (1 << ROUTER_TABLE_BITS)
+
+// Valid sACN universe range
+#define SACN_UNIVERSE_MIN 1
+#define SACN_UNIVERSE_MAX 63999
+
+/**
+ * @brief Hash table entry: one (protocol, universe) key and its merge
+ */
+typedef struct {
+    bool used;
+    uint8_t protocol;
+    uint16_t universe;
+    uint8_t merge;
+} route_entry_t;
+
+/**
+ * @brief Routing table
+ */
+typedef struct {
+    route_entry_t entries[ROUTER_TABLE_SIZE];
+    uint8_t route_count;           /**< Also the number of merges */
+    universe_merge_info_t merges[UNIVERSE_ROUTER_MAX_ROUTES]; /**< By merge number - 1 */
+    universe_route_t port_routes[UNIVERSE_ROUTER_PORTS][UNIVERSE_ROUTER_PORT_MERGES];
+    uint8_t port_route_count[UNIVERSE_ROUTER_PORTS];
+} route_table_t;
+
+/**
+ * @brief Module state
+ */
+static struct {
+    bool initialized;
+    route_table_t tables[2];       /**< Active table and rebuild target */
+    atomic_uint active;            /**< Index of the table readers use */
+    SemaphoreHandle_t mutex;       /**< Serializes rebuilds */
+} router_state = {
+    .initialized = false,
+};
+
+/**
+ * @brief Hash a (protocol, universe) key to a table index
+ */
+static inline uint32_t route_hash(router_protocol_t protocol, uint16_t universe)
+{
+    uint32_t key = ((uint32_t)protocol << 16) | universe;
+    return (key * 2654435761u) >> (32 - ROUTER_TABLE_BITS);
+}
+
+/**
+ * @brief Find the entry for a key, or NULL
+ */
+static const route_entry_t* find_entry(const route_table_t *table,
+                                       router_protocol_t protocol, uint16_t universe)
+{
+    uint32_t index = route_hash(protocol, universe);
+    
+    for (int probe = 0; probe < ROUTER_TABLE_SIZE; probe++) {
+        const route_entry_t *entry = &table->entries[(index + probe) & (ROUTER_TABLE_SIZE - 1)];
+        if (!entry->used) {
+            return NULL;
+        }
+        if (entry->protocol == protocol && entry->universe == universe) {
+            return entry;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Normalize a universe number, false if it can never be routed
+ */
+static bool normalize_universe(router_protocol_t protocol, uint16_t *universe)
+{
+    if (protocol == ROUTER_PROTOCOL_ARTNET) {
+        *universe &= 0x7FFF;  // 15-bit Port-Address
+        return true;
+    }
+    
+    return *universe >= SACN_UNIVERSE_MIN && *universe <= SACN_UNIVERSE_MAX;
+}
+
+/**
+ * @brief Protocol name for log messages
+ */
+static const char* protocol_name(router_protocol_t protocol)
+{
+    return protocol == ROUTER_PROTOCOL_ARTNET ? "Art-Net" : "sACN";
+}
+
+/**
+ * @brief Whether a port takes input from a protocol
+ */
+static bool port_accepts(const port_config_t *port, router_protocol_t protocol)
+{
+    switch (port->protocol_mode) {
+        case PROTOCOL_ARTNET_ONLY:
+            return protocol == ROUTER_PROTOCOL_ARTNET;
+        case PROTOCOL_SACN_ONLY:
+            return protocol == ROUTER_PROTOCOL_SACN;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Whether two ports merge a universe they share the same way
+ * 
+ * Channel-mode maps are in port channels, so they only match at the same
+ * offset.
+ */
+static bool merge_settings_match(const port_config_t *a, int16_t a_offset,
+                                 const port_config_t *b, int16_t b_offset)
+{
+    return a->merge_mode == b->merge_mode &&
+           a->short_frame_policy == b->short_frame_policy &&
+           a->channel_mode_count == b->channel_mode_count &&
+           (a->channel_mode_count == 0 ||
+            (a_offset == b_offset &&
+             memcmp(a->channel_modes, b->channel_modes,
+                    a->channel_mode_count * sizeof(channel_mode_range_t)) == 0));
+}
+
+/**
+ * @brief Find or add the merge of a key in a table under construction
+ * 
+ * A new key gets the next merge number and the settings of the port adding
+ * it; a later port only subscribes.
+ * 
+ * @return Merge number, 0 if the table is full
+ */
+static uint8_t add_merge(route_table_t *table, const config_t *config,
+                         router_protocol_t protocol, uint16_t universe,
+                         uint8_t port, int16_t offset)
+{
+    uint32_t index = route_hash(protocol, universe);
+    route_entry_t *entry = NULL;
+    
+    for (int probe = 0; probe < ROUTER_TABLE_SIZE; probe++) {
+        route_entry_t *candidate = &table->entries[(index + probe) & (ROUTER_TABLE_SIZE - 1)];
+        if (!candidate->used ||
+            (candidate->protocol == protocol && candidate->universe == universe)) {
+            entry = candidate;
+            break;
+        }
+    }
+    
+    if (entry && entry->used) {
+        const universe_merge_info_t *info = &table->merges[entry->merge - 1];
+        if (info->port != port &&
+            !merge_settings_match(config_get_port(config, port), offset,
+                                  config_get_port(config, info->port), info->offset)) {
+            ESP_LOGW(TAG, "%s universe %d: port %d merge settings differ, port %d's apply",
+                     protocol_name(protocol), universe, port, info->port);
+        }
+        return entry->merge;
+    }
+    
+    if (!entry || table->route_count >= UNIVERSE_ROUTER_MAX_ROUTES) {
+        ESP_LOGE(TAG, "Routing table full");
+        return 0;
+    }
+    
+    entry->used = true;
+    entry->protocol = protocol;
+    entry->universe = universe;
+    entry->merge = ++table->route_count;
+    table->merges[entry->merge - 1] = (universe_merge_info_t){
+        .protocol = protocol,
+        .universe = universe,
+        .port = port,
+        .offset = offset,
+    };
+    
+    return entry->merge;
+}
+
+/**
+ * @brief Route one universe of a port: its merge, read at the given offset
+ */
+static esp_err_t add_port_route(route_table_t *table, const config_t *config, uint8_t port,
+                                router_protocol_t protocol, uint16_t universe, int16_t offset)
+{
+    if (!normalize_universe(protocol, &universe)) {
+        return ESP_OK;  // Nothing to receive on this universe
+    }
+    
+    uint8_t merge = add_merge(table, config, protocol, universe, port, offset);
+    if (!merge) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    universe_route_t *routes = table->port_routes[port - 1];
+    uint8_t *count = &table->port_route_count[port - 1];
+    for (int i = 0; i < *count; i++) {
+        if (routes[i].merge == merge && routes[i].offset == offset) {
+            return ESP_OK;
+        }
+    }
+    
+    if (*count >= UNIVERSE_ROUTER_PORT_MERGES) {
+        ESP_LOGE(TAG, "Too many merges for port %d", port);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    routes[*count].merge = merge;
+    routes[*count].offset = offset;
+    (*count)++;
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Route the universes of a port
+ * 
+ * The primary universe maps 1:1; the secondary (if set) is shifted by
+ * universe_offset channels. A port taking both protocols reads the merge
+ * of each, the protocol it prefers first.
+ */
+static esp_err_t add_port_routes(route_table_t *table, const config_t *config, uint8_t port)
+{
+    const port_config_t *port_cfg = config_get_port(config, port);
+    if (!port_cfg || port_cfg->mode == DMX_MODE_DISABLED) {
+        return ESP_OK;
+    }
+    
+    router_protocol_t protocols[2] = { ROUTER_PROTOCOL_ARTNET, ROUTER_PROTOCOL_SACN };
+    if (port_cfg->protocol_mode == PROTOCOL_SACN_PRIORITY) {
+        protocols[0] = ROUTER_PROTOCOL_SACN;
+        protocols[1] = ROUTER_PROTOCOL_ARTNET;
+    }
+    
+    esp_err_t ret = ESP_OK;
+    for (int i = 0; i < 2 && ret == ESP_OK; i++) {
+        if (port_accepts(port_cfg, protocols[i])) {
+            ret = add_port_route(table, config, port, protocols[i],
+                                 port_cfg->universe_primary, 0);
+        }
+    }
+    
+    if (port_cfg->universe_secondary >= 0) {
+        for (int i = 0; i < 2 && ret == ESP_OK; i++) {
+            if (port_accepts(port_cfg, protocols[i])) {
+                ret = add_port_route(table, config, port, protocols[i],
+                                     port_cfg->universe_secondary, port_cfg->universe_offset);
+            }
+        }
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief Get the table readers use
+ */
+static inline const route_table_t* active_table(void)
+{
+    uint32_t active = atomic_load_explicit(&router_state.active, memory_order_acquire);
+    return &router_state.tables[active];
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+esp_err_t universe_router_init(void)
+{
+    if (router_state.initialized) {
+        ESP_LOGW(TAG, "Already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    router_state.mutex = xSemaphoreCreateMutex();
+    if (!router_state.mutex) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    memset(router_state.tables, 0, sizeof(router_state.tables));
+    atomic_store(&router_state.active, 0);
+    
+    router_state.initialized = true;
+    ESP_LOGI(TAG, "Universe router initialized");
+    
+    return ESP_OK;
+}
+
+esp_err_t universe_router_build(const config_t *config)
+{
+    if (!router_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(router_state.mutex, portMAX_DELAY);
+    
+    uint32_t next = atomic_load(&router_state.active) ^ 1;
+    route_table_t *table = &router_state.tables[next];
+    memset(table, 0, sizeof(route_table_t));
+    
+    // Ports outputting the same universe share its merge: each received
+    // frame is pushed and merged once for all of them
+    esp_err_t ret = ESP_OK;
+    for (uint8_t port = 1; port <= UNIVERSE_ROUTER_PORTS && ret == ESP_OK; port++) {
+        ret = add_port_routes(table, config, port);
+    }
+    
+    if (ret == ESP_OK) {
+        atomic_store_explicit(&router_state.active, next, memory_order_release);
+        ESP_LOGI(TAG, "Routing table rebuilt: %d universe merges for %d ports",
+                 table->route_count, UNIVERSE_ROUTER_PORTS);
+    }
+    
+    xSemaphoreGive(router_state.mutex);
+    
+    return ret;
+}
+
+bool universe_router_is_routed(router_protocol_t protocol, uint16_t universe)
+{
+    if (!router_state.initialized || !normalize_universe(protocol, &universe)) {
+        return false;
+    }
+    
+    return find_entry(active_table(), protocol, universe) != NULL;
+}
+
+uint8_t universe_router_lookup(router_protocol_t protocol, uint16_t universe)
+{
+    if (!router_state.initialized || !normalize_universe(protocol, &universe)) {
+        return 0;
+    }
+    
+    const route_entry_t *entry = find_entry(active_table(), protocol, universe);
+    
+    return entry ? entry->merge : 0;
+}
+
+uint8_t universe_router_get_merge_count(void)
+{
+    if (!router_state.initialized) {
+        return 0;
+    }
+    
+    return active_table()->route_count;
+}
+
+esp_err_t universe_router_get_merge(uint8_t merge, universe_merge_info_t *info)
+{
+    if (!router_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const route_table_t *table = active_table();
+    if (merge < 1 || merge > table->route_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    *info = table->merges[merge - 1];
+    
+    return ESP_OK;
+}
+
+uint8_t universe_router_get_port_routes(uint8_t port, universe_route_t *routes,
+                                        uint8_t max_routes)
+{
+    if (!router_state.initialized || !routes || port < 1 || port > UNIVERSE_ROUTER_PORTS) {
+        return 0;
+    }
+    
+    const route_table_t *table = active_table();
+    uint8_t count = table->port_route_count[port - 1];
+    if (count > max_routes) {
+        count = max_routes;
+    }
+    memcpy(routes, table->port_routes[port - 1], count * sizeof(universe_route_t));
+    
+    return count;
+}
+
+uint8_t universe_router_get_universes(router_protocol_t protocol, uint16_t *universes,
+                                      uint8_t max_universes)
+{
+    if (!router_state.initialized || !universes) {
+        return 0;
+    }
+    
+    const route_table_t *table = active_table();
+    
+    uint8_t count = 0;
+    for (int i = 0; i < ROUTER_TABLE_SIZE && count < max_universes; i++) {
+        const route_entry_t *entry = &table->entries[i];
+        if (entry->used && entry->protocol == protocol) {
+            universes[count++] = entry->universe;
+        }
+    }
+    
+    return count;
+}
+
+uint8_t universe_router_get_port_universes(router_protocol_t protocol, uint8_t port,
+                                           uint16_t *universes, uint8_t max_universes)
+{
+    if (!router_state.initialized || !universes || port < 1 || port > UNIVERSE_ROUTER_PORTS) {
+        return 0;
+    }
+    
+    // Routes are in primary, secondary order; keep each universe once
+    const route_table_t *table = active_table();
+    uint8_t count = 0;
+    for (int r = 0; r < table->port_route_count[port - 1] && count < max_universes; r++) {
+        const universe_merge_info_t *info = &table->merges[table->port_routes[port - 1][r].merge - 1];
+        if (info->protocol != protocol) {
+            continue;
+        }
+        
+        bool listed = false;
+        for (int i = 0; i < count; i++) {
+            listed |= (universes[i] == info->universe);
+        }
+        if (!listed) {
+            universes[count++] = info->universe;
+        }
+    }
+    
+    return count;
+}
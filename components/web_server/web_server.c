@@ -30,6 +30,7 @@
 #include "dmx_handler.h"
 #include "artnet_receiver.h"
 #include "sacn_receiver.h"
+#include "udp_dispatcher.h"
 #include "merge_engine.h"
 
 // Embedded web files
@@ -515,6 +516,9 @@ static esp_err_t api_config_post_handler(httpd_req_t *req)
         return ESP_FAIL;
     }
     
+    // Names and universes are announced in ArtPollReply
+    artnet_receiver_refresh_poll_reply();
+    
     cJSON *response = cJSON_CreateObject();
     cJSON_AddStringToObject(response, "status", "ok");
     cJSON_AddStringToObject(response, "message", "Configuration updated successfully (restart required for some changes)");
@@ -572,6 +576,8 @@ static esp_err_t api_ports_status_handler(httpd_req_t *req)
         cJSON_AddNumberToObject(port1, "mode", status1.mode);
         cJSON_AddNumberToObject(port1, "frames_sent", status1.stats.frames_sent);
         cJSON_AddNumberToObject(port1, "frames_received", status1.stats.frames_received);
+        cJSON_AddNumberToObject(port1, "driver_writes", status1.stats.driver_writes);
+        cJSON_AddNumberToObject(port1, "buffer_copies", status1.stats.buffer_copies);
         cJSON_AddItemToArray(json, port1);
     }
     
@@ -584,6 +590,8 @@ static esp_err_t api_ports_status_handler(httpd_req_t *req)
         cJSON_AddNumberToObject(port2, "mode", status2.mode);
         cJSON_AddNumberToObject(port2, "frames_sent", status2.stats.frames_sent);
         cJSON_AddNumberToObject(port2, "frames_received", status2.stats.frames_received);
+        cJSON_AddNumberToObject(port2, "driver_writes", status2.stats.driver_writes);
+        cJSON_AddNumberToObject(port2, "buffer_copies", status2.stats.buffer_copies);
         cJSON_AddItemToArray(json, port2);
     }
     
@@ -614,6 +622,8 @@ static esp_err_t api_port_config_get_handler(httpd_req_t *req)
     cJSON_AddNumberToObject(json, "mode", port_cfg->mode);
     cJSON_AddNumberToObject(json, "universe_primary", port_cfg->universe_primary);
     cJSON_AddNumberToObject(json, "merge_mode", port_cfg->merge_mode);
+    cJSON_AddNumberToObject(json, "short_frame_policy", port_cfg->short_frame_policy);
+    cJSON_AddNumberToObject(json, "channel_mode_ranges", port_cfg->channel_mode_count);
     
     send_json_response(req, json, 200);
     cJSON_Delete(json);
@@ -688,6 +698,10 @@ static esp_err_t api_system_stats_handler(httpd_req_t *req)
         cJSON_AddNumberToObject(artnet, "packets", artnet_stats.packets_received);
         cJSON_AddNumberToObject(artnet, "dmx_packets", artnet_stats.dmx_packets);
         cJSON_AddNumberToObject(artnet, "poll_packets", artnet_stats.poll_packets);
+        cJSON_AddNumberToObject(artnet, "poll_rate_limited", artnet_stats.poll_rate_limited);
+        cJSON_AddNumberToObject(artnet, "unrouted_packets", artnet_stats.unrouted_packets);
+        cJSON_AddNumberToObject(artnet, "sync_packets", artnet_stats.sync_packets);
+        cJSON_AddNumberToObject(artnet, "sequence_drops", artnet_stats.sequence_drops);
         cJSON_AddItemToObject(json, "artnet", artnet);
     }
     
@@ -697,24 +711,70 @@ static esp_err_t api_system_stats_handler(httpd_req_t *req)
         cJSON *sacn = cJSON_CreateObject();
         cJSON_AddNumberToObject(sacn, "packets", sacn_stats.packets_received);
         cJSON_AddNumberToObject(sacn, "data_packets", sacn_stats.data_packets);
+        cJSON_AddNumberToObject(sacn, "priority_packets", sacn_stats.priority_packets);
+        cJSON_AddNumberToObject(sacn, "unrouted_packets", sacn_stats.unrouted_packets);
+        cJSON_AddNumberToObject(sacn, "sync_packets", sacn_stats.sync_packets);
+        cJSON_AddNumberToObject(sacn, "staged_drops", sacn_stats.staged_drops);
+        cJSON_AddNumberToObject(sacn, "sequence_drops", sacn_stats.sequence_drops);
         cJSON_AddItemToObject(json, "sacn", sacn);
     }
     
-    // Merge engine stats
-    merge_stats_t merge1, merge2;
-    if (merge_engine_get_stats(1, &merge1) == ESP_OK) {
-        cJSON *merge = cJSON_CreateObject();
-        cJSON_AddNumberToObject(merge, "active_sources", merge1.active_sources);
-        cJSON_AddNumberToObject(merge, "total_merges", merge1.total_merges);
-        cJSON_AddItemToObject(json, "merge_port1", merge);
+    // Receive dispatcher stats
+    udp_dispatcher_stats_t rx_stats;
+    if (udp_dispatcher_get_stats(&rx_stats) == ESP_OK) {
+        cJSON *rx = cJSON_CreateObject();
+        cJSON_AddNumberToObject(rx, "datagrams", rx_stats.datagrams);
+        cJSON_AddNumberToObject(rx, "batches", rx_stats.batches);
+        cJSON_AddNumberToObject(rx, "queue_depth_max", rx_stats.queue_depth_max);
+        cJSON_AddNumberToObject(rx, "pool_full", rx_stats.pool_full);
+        cJSON_AddNumberToObject(rx, "truncated_drops", rx_stats.truncated_drops);
+        cJSON_AddItemToObject(json, "udp_rx", rx);
     }
     
-    if (merge_engine_get_stats(2, &merge2) == ESP_OK) {
+    cJSON_AddBoolToObject(json, "sync_active", merge_engine_is_sync_active());
+    
+    // Merge engine stats, one merge per routed universe
+    cJSON *merges = cJSON_CreateArray();
+    for (uint8_t m = 1; m <= MERGE_MAX_MERGES; m++) {
+        merge_stats_t stats;
+        if (merge_engine_get_stats(m, &stats) != ESP_OK || stats.subscribers == 0) {
+            continue;
+        }
         cJSON *merge = cJSON_CreateObject();
-        cJSON_AddNumberToObject(merge, "active_sources", merge2.active_sources);
-        cJSON_AddNumberToObject(merge, "total_merges", merge2.total_merges);
-        cJSON_AddItemToObject(json, "merge_port2", merge);
+        cJSON_AddNumberToObject(merge, "merge", m);
+        cJSON_AddNumberToObject(merge, "active_sources", stats.active_sources);
+        cJSON_AddNumberToObject(merge, "total_merges", stats.total_merges);
+        cJSON_AddNumberToObject(merge, "active_priority", stats.active_priority);
+        cJSON_AddNumberToObject(merge, "slot_copies", stats.slot_copies);
+        cJSON_AddNumberToObject(merge, "output_refs", stats.output_refs);
+        cJSON_AddNumberToObject(merge, "output_cow_copies", stats.output_cow_copies);
+        cJSON_AddNumberToObject(merge, "output_copies", stats.output_copies);
+        cJSON_AddNumberToObject(merge, "source_overflows", stats.source_overflows);
+        cJSON_AddNumberToObject(merge, "pool_free", stats.pool_free);
+        cJSON_AddNumberToObject(merge, "source_timeouts", stats.source_timeouts);
+        cJSON_AddNumberToObject(merge, "subscribers", stats.subscribers);
+        cJSON_AddItemToArray(merges, merge);
+    }
+    cJSON_AddItemToObject(json, "merges", merges);
+    
+    // The merges each port composes its output from
+    cJSON *ports = cJSON_CreateArray();
+    for (uint8_t port = 1; port <= MERGE_MAX_PORTS; port++) {
+        merge_subscription_t subs[MERGE_PORT_MERGES];
+        uint8_t count = merge_engine_get_port_merges(port, subs, MERGE_PORT_MERGES);
+        cJSON *port_json = cJSON_CreateObject();
+        cJSON *port_merges = cJSON_CreateArray();
+        cJSON_AddNumberToObject(port_json, "port", port);
+        for (int i = 0; i < count; i++) {
+            cJSON *sub = cJSON_CreateObject();
+            cJSON_AddNumberToObject(sub, "merge", subs[i].merge);
+            cJSON_AddNumberToObject(sub, "offset", subs[i].offset);
+            cJSON_AddItemToArray(port_merges, sub);
+        }
+        cJSON_AddItemToObject(port_json, "merges", port_merges);
+        cJSON_AddItemToArray(ports, port_json);
     }
+    cJSON_AddItemToObject(json, "merge_ports", ports);
     
     send_json_response(req, json, 200);
     cJSON_Delete(json);
@@ -826,8 +886,11 @@ static esp_err_t ws_handler(httpd_req_t *req)
                                     uint8_t dmx_data[512] = {0};
                                     dmx_data[channel - 1] = (uint8_t)value;
                                     
-                                    // Send via merge engine (using special WebSocket source identifiers)
-                                    merge_engine_push_artnet(port, WS_TEST_UNIVERSE, dmx_data, 0, WS_TEST_SOURCE_IP);
+                                    // Send via the port's primary merge (using special WebSocket source identifiers)
+                                    merge_subscription_t sub;
+                                    if (merge_engine_get_port_merges(port, &sub, 1) == 1) {
+                                        merge_engine_push_artnet(sub.merge, WS_TEST_UNIVERSE, dmx_data, 512, 0, WS_TEST_SOURCE_IP);
+                                    }
                                     
                                     // Send success response
                                     cJSON *response = cJSON_CreateObject();
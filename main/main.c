@@ -11,12 +11,18 @@
 #include "dmx_handler.h"
 #include "artnet_receiver.h"
 #include "sacn_receiver.h"
+#include "udp_dispatcher.h"
+#include "universe_router.h"
 #include "merge_engine.h"
 #include "web_server.h"
 #include "lwip/ip_addr.h"
 
 static const char *TAG = "main";
 
+#if UNIVERSE_ROUTER_MAX_ROUTES > MERGE_MAX_MERGES || UNIVERSE_ROUTER_PORT_MERGES > MERGE_PORT_MERGES
+#error "Merge engine too small for the routing table"
+#endif
+
 // Helper function to convert DMX mode to string
 static const char* dmx_mode_to_string(dmx_mode_t mode) {
     switch (mode) {
@@ -54,6 +60,9 @@ static void network_state_changed(network_state_t state, void *user_data)
             led_manager_set_state(LED_STATE_BOOT);
             break;
     }
+    
+    // The address in ArtPollReply may have changed
+    artnet_receiver_refresh_poll_reply();
 }
 
 // Art-Net DMX data callback
@@ -63,16 +72,11 @@ static void on_artnet_dmx(uint16_t universe, const uint8_t *data,
 {
     ESP_LOGD(TAG, "Art-Net DMX received: Universe=%d, Length=%d, Seq=%d, SourceIP=0x%08" PRIx32,
              universe, length, sequence, source_ip);
-    
-    // Route to appropriate DMX port based on universe
-    config_t *config = config_get();
-    
-    if (config->port1.universe_primary == universe) {
-        merge_engine_push_artnet(1, universe, data, sequence, source_ip);
-    }
-    
-    if (config->port2.universe_primary == universe) {
-        merge_engine_push_artnet(2, universe, data, sequence, source_ip);
+             
+    // Pushed once into the universe's merge, however many ports output it
+    uint8_t merge = universe_router_lookup(ROUTER_PROTOCOL_ARTNET, universe);
+    if (merge) {
+        merge_engine_push_artnet(merge, universe, data, length, sequence, source_ip);
     }
 }
 
@@ -80,51 +84,209 @@ static void on_artnet_dmx(uint16_t universe, const uint8_t *data,
 static void on_sacn_dmx(uint16_t universe, const uint8_t *data,
                         uint8_t priority, uint8_t sequence,
                         bool preview, const char *source_name,
-                        uint32_t source_ip, void *user_data)
+                        const uint8_t *cid, uint32_t source_ip, void *user_data)
 {
-    ESP_LOGD(TAG, "sACN DMX received: Universe=%d, Priority=%d, Seq=%d, Preview=%d, Source=%s, SourceIP=0x%08" PRIx32,
+    ESP_LOGD(TAG, "sACN DMX received: Universe=%d, Priority=%d, Seq=%d, Preview=%d, Source=%.64s, SourceIP=0x%08" PRIx32,
              universe, priority, sequence, preview, source_name, source_ip);
-    
+             
     // Skip preview data
     if (preview) {
         return;
     }
     
-    // Route to appropriate DMX port based on universe
-    config_t *config = config_get();
+    // Pushed once into the universe's merge, however many ports output it
+    uint8_t merge = universe_router_lookup(ROUTER_PROTOCOL_SACN, universe);
+    if (merge) {
+        merge_engine_push_sacn(merge, universe, data, sequence, priority, source_name,
+                               cid, source_ip);
+    }
+}
+
+// sACN per-address priority callback (start code 0xDD, ~1 Hz)
+static void on_sacn_priority(uint16_t universe, const uint8_t *priorities,
+                             uint8_t sequence, const char *source_name,
+                             const uint8_t *cid, uint32_t source_ip, void *user_data)
+{
+    ESP_LOGD(TAG, "sACN priority map received: Universe=%d, Seq=%d, Source=%.64s",
+             universe, sequence, source_name);
+             
+    uint8_t merge = universe_router_lookup(ROUTER_PROTOCOL_SACN, universe);
+    if (merge) {
+        merge_engine_push_sacn_priority(merge, universe, priorities, source_name, cid,
+                                        source_ip);
+    }
+}
+
+// sACN stream terminated callback - drop the source now, not after the timeout
+static void on_sacn_terminate(uint16_t universe, const uint8_t *cid,
+                              uint32_t source_ip, void *user_data)
+{
+    ESP_LOGD(TAG, "sACN stream terminated: Universe=%d, SourceIP=0x%08" PRIx32,
+             universe, source_ip);
+             
+    uint8_t merge = universe_router_lookup(ROUTER_PROTOCOL_SACN, universe);
+    if (merge) {
+        merge_engine_terminate_sacn(merge, universe, cid);
+    }
+}
+
+// Latch the merges of one protocol's universes at once
+static void latch_protocol_merges(router_protocol_t protocol, uint32_t timeout_ms)
+{
+    uint8_t merges[UNIVERSE_ROUTER_MAX_ROUTES];
+    uint8_t count = 0;
+    uint8_t merge_count = universe_router_get_merge_count();
+    
+    for (uint8_t merge = 1; merge <= merge_count; merge++) {
+        universe_merge_info_t info;
+        if (universe_router_get_merge(merge, &info) == ESP_OK && info.protocol == protocol) {
+            merges[count++] = merge;
+        }
+    }
     
-    if (config->port1.universe_primary == universe) {
-        merge_engine_push_sacn(1, universe, data, sequence, priority, source_name, source_ip);
+    if (count > 0) {
+        merge_engine_sync_latch(merges, count, timeout_ms);
+    }
+}
+
+// ArtSync callback - latch the merges of the Art-Net universes at once
+static void on_artnet_sync(uint32_t source_ip, void *user_data)
+{
+    latch_protocol_merges(ROUTER_PROTOCOL_ARTNET, ARTNET_SYNC_TIMEOUT_MS);
+}
+
+// sACN sync callback - the held frames of this sync address were just pushed;
+// latch the merges of its universes so every output changes on this sync
+static void on_sacn_sync(uint16_t sync_address, const uint16_t *universes,
+                         uint8_t universe_count, uint32_t source_ip, void *user_data)
+{
+    uint8_t merges[UNIVERSE_ROUTER_MAX_ROUTES];
+    uint8_t count = 0;
+    
+    ESP_LOGD(TAG, "sACN sync received: Sync universe=%d, %d universes",
+             sync_address, universe_count);
+             
+    for (int i = 0; i < universe_count && count < UNIVERSE_ROUTER_MAX_ROUTES; i++) {
+        uint8_t merge = universe_router_lookup(ROUTER_PROTOCOL_SACN, universes[i]);
+        if (merge) {
+            merges[count++] = merge;
+        }
     }
     
-    if (config->port2.universe_primary == universe) {
-        merge_engine_push_sacn(2, universe, data, sequence, priority, source_name, source_ip);
+    if (count > 0) {
+        merge_engine_sync_latch(merges, count, SACN_SYNC_TIMEOUT_MS);
     }
 }
 
-// DMX output task - pulls merged data and sends to DMX ports
-static void dmx_output_task(void *arg)
+// Merge source expiry callback - runs on the output task with the merge locked
+static void on_merge_sources_expired(uint8_t merge, uint8_t expired, uint8_t remaining,
+                                     void *user_data)
+{
+    ESP_LOGD(TAG, "Merge %d: %d sources timed out, %d remaining", merge, expired, remaining);
+    
+    led_manager_set_state(LED_STATE_SOURCE_LOST);
+}
+
+// A port's channel-mode map in the channels of a universe it reads at an offset
+static uint8_t universe_channel_modes(const port_config_t *port_cfg, int16_t offset,
+                                      channel_mode_range_t *ranges)
 {
-    uint8_t merged_data[512];
+    uint8_t count = 0;
+    
+    for (int r = 0; r < port_cfg->channel_mode_count; r++) {
+        const channel_mode_range_t *range = &port_cfg->channel_modes[r];
+        int start = range->start - offset;
+        int end = start + range->count;
+        if (start < 0) {
+            start = 0;
+        }
+        if (end > 512) {
+            end = 512;
+        }
+        if (start < end) {
+            ranges[count].start = start;
+            ranges[count].count = end - start;
+            ranges[count].mode = range->mode;
+            count++;
+        }
+    }
     
-    ESP_LOGI(TAG, "DMX output task started");
+    return count;
+}
+
+// Configure each universe merge from the port it was routed for, then
+// subscribe every port to the merges of its universes. A setting the engine
+// refuses is logged and replaced by its default, so a bad configuration
+// never keeps the node from booting.
+static void configure_merges(const config_t *config)
+{
+    uint8_t merge_count = universe_router_get_merge_count();
+    uint32_t timeout_ms = config->merge.timeout_seconds * 1000;
     
-    while (1) {
-        // Port 1
-        if (merge_engine_get_output(1, merged_data) == ESP_OK) {
-            dmx_handler_send_dmx(DMX_PORT_1, merged_data);
+    for (uint8_t merge = 1; merge <= merge_count; merge++) {
+        universe_merge_info_t info;
+        if (universe_router_get_merge(merge, &info) != ESP_OK) {
+            continue;
         }
         
-        // Port 2
-        if (merge_engine_get_output(2, merged_data) == ESP_OK) {
-            dmx_handler_send_dmx(DMX_PORT_2, merged_data);
+        const port_config_t *port_cfg = config_get_port(config, info.port);
+        channel_mode_range_t ranges[CONFIG_MAX_CHANNEL_MODE_RANGES];
+        uint8_t range_count = universe_channel_modes(port_cfg, info.offset, ranges);
+        
+        if (merge_engine_config(merge, port_cfg->merge_mode, timeout_ms) != ESP_OK) {
+            ESP_LOGW(TAG, "Merge %d: merge mode %d refused, using HTP", merge, port_cfg->merge_mode);
+            merge_engine_config(merge, MERGE_MODE_HTP, timeout_ms);
+        }
+        if (merge_engine_set_short_frame_policy(merge, port_cfg->short_frame_policy) != ESP_OK) {
+            ESP_LOGW(TAG, "Merge %d: short frame policy %d refused, holding values",
+                     merge, port_cfg->short_frame_policy);
+            merge_engine_set_short_frame_policy(merge, SHORT_FRAME_HOLD);
+        }
+        if (merge_engine_set_channel_modes(merge, ranges, range_count) != ESP_OK) {
+            ESP_LOGW(TAG, "Merge %d: channel-mode map refused, not used", merge);
+            merge_engine_set_channel_modes(merge, NULL, 0);
+        }
+        ESP_LOGI(TAG, "Merge %d: %s universe %d, settings of port %d",
+                 merge, info.protocol == ROUTER_PROTOCOL_ARTNET ? "Art-Net" : "sACN",
+                 info.universe, info.port);
+    }
+    
+    for (uint8_t port = 1; port <= MERGE_MAX_PORTS; port++) {
+        universe_route_t routes[UNIVERSE_ROUTER_PORT_MERGES];
+        merge_subscription_t merges[MERGE_PORT_MERGES];
+        uint8_t count = universe_router_get_port_routes(port, routes, UNIVERSE_ROUTER_PORT_MERGES);
+        for (int i = 0; i < count; i++) {
+            merges[i].merge = routes[i].merge;
+            merges[i].offset = routes[i].offset;
         }
         
-        // Run at ~44Hz to match DMX output rate
-        vTaskDelay(pdMS_TO_TICKS(23));
+        merge_mode_t mode = config_get_port(config, port)->merge_mode;
+        if (merge_engine_subscribe(port, merges, count, mode) != ESP_OK) {
+            // The first route is the port's primary universe, at offset 0
+            ESP_LOGW(TAG, "Port %d: merges refused, outputting its primary universe with HTP", port);
+            merge_engine_subscribe(port, merges, count > 0 ? 1 : 0, MERGE_MODE_HTP);
+        }
     }
 }
 
+// DMX frame source - called by each output port at its frame boundary
+static esp_err_t merged_frame_source(uint8_t port, const uint8_t **frame, void *user_data)
+{
+    // Ports only wait for each other at frame boundaries while a sync
+    // latch is in effect; otherwise a slow port must not pace the other
+    dmx_handler_set_frame_sync(merge_engine_is_sync_active());
+    
+    // Re-merges only if a source changed since the previous frame; the port
+    // borrows the merged buffer itself
+    return merge_engine_acquire_output(port, frame);
+}
+
+// DMX frame release - the port is done with a borrowed merged frame
+static void merged_frame_release(uint8_t port, const uint8_t *frame, void *user_data)
+{
+    merge_engine_release_output(frame);
+}
+
 void app_main(void)
 {
     ESP_LOGI(TAG, "ESP-NODE-2RDM Firmware v0.1.0");
@@ -147,7 +309,7 @@ void app_main(void)
     
     config_t *config = config_get();
     ESP_LOGI(TAG, "Node: %s", config->node_info.short_name);
-
+    
     // Initialize LED Manager
     ESP_ERROR_CHECK(led_manager_init());
     led_manager_set_state(LED_STATE_BOOT);
@@ -185,50 +347,58 @@ void app_main(void)
     
     // Initialize Merge Engine
     ESP_LOGI(TAG, "Initializing merge engine...");
-    ESP_ERROR_CHECK(merge_engine_init());
-    
-    // Configure merge engine for both ports
+    merge_pool_config_t merge_pool = {
+        .sources = config->merge.source_pool_size,
+        .cold_in_psram = config->merge.pool_in_psram,
+    };
+    ESP_ERROR_CHECK(merge_engine_init(&merge_pool));
+    
+    // Build universe routing table (receivers drop everything not in it)
+    ESP_LOGI(TAG, "Building universe routing table...");
+    ESP_ERROR_CHECK(universe_router_init());
+    ESP_ERROR_CHECK(universe_router_build(config));
+    
+    // One merge per routed universe; each port reads the merges of its universes
     ESP_LOGI(TAG, "Configuring merge engine...");
-    ESP_ERROR_CHECK(merge_engine_config(1, config->port1.merge_mode, config->merge.timeout_seconds * 1000));
-    ESP_ERROR_CHECK(merge_engine_config(2, config->port2.merge_mode, config->merge.timeout_seconds * 1000));
+    configure_merges(config);
+    ESP_ERROR_CHECK(merge_engine_set_expiry_callback(on_merge_sources_expired, NULL));
     
     // Initialize Protocol Receivers
     ESP_LOGI(TAG, "Initializing protocol receivers...");
     
+    // One task receives for both protocols
+    ESP_ERROR_CHECK(udp_dispatcher_init());
+    
     // Art-Net Receiver
     ESP_LOGI(TAG, "Initializing Art-Net receiver...");
     ESP_ERROR_CHECK(artnet_receiver_init());
     ESP_ERROR_CHECK(artnet_receiver_set_callback(on_artnet_dmx, NULL));
+    ESP_ERROR_CHECK(artnet_receiver_set_sync_callback(on_artnet_sync, NULL));
     ESP_ERROR_CHECK(artnet_receiver_start());
     
     // sACN Receiver
     ESP_LOGI(TAG, "Initializing sACN receiver...");
     ESP_ERROR_CHECK(sacn_receiver_init());
     ESP_ERROR_CHECK(sacn_receiver_set_callback(on_sacn_dmx, NULL));
+    ESP_ERROR_CHECK(sacn_receiver_set_priority_callback(on_sacn_priority, NULL));
+    ESP_ERROR_CHECK(sacn_receiver_set_sync_callback(on_sacn_sync, NULL));
+    ESP_ERROR_CHECK(sacn_receiver_set_terminate_callback(on_sacn_terminate, NULL));
     ESP_ERROR_CHECK(sacn_receiver_start());
     
-    // Subscribe to universes for sACN
+    // Subscribe to the sACN universes the routing table needs
     ESP_LOGI(TAG, "Subscribing to sACN universes...");
-    if (config->port1.universe_primary > 0) {
-        ESP_ERROR_CHECK(sacn_receiver_subscribe_universe(config->port1.universe_primary));
-    }
-    if (config->port2.universe_primary > 0 && 
-        config->port2.universe_primary != config->port1.universe_primary) {
-        ESP_ERROR_CHECK(sacn_receiver_subscribe_universe(config->port2.universe_primary));
-    }
-    
-    // Start DMX output task (pulls merged data and sends to ports)
-    ESP_LOGI(TAG, "Starting DMX output task...");
-    xTaskCreatePinnedToCore(
-        dmx_output_task,
-        "dmx_out_merge",
-        4096,
-        NULL,
-        10,
-        NULL,
-        1  // Run on Core 1 with DMX tasks
-    );
-    
+    uint16_t sacn_universes[UNIVERSE_ROUTER_MAX_ROUTES];
+    uint8_t sacn_count = universe_router_get_universes(ROUTER_PROTOCOL_SACN, sacn_universes,
+                                                       UNIVERSE_ROUTER_MAX_ROUTES);
+    ESP_ERROR_CHECK(sacn_receiver_set_universes(sacn_universes, sacn_count));
+    
+    // Feed merged data to the DMX ports, paced by each port's transmit completion
+    ESP_LOGI(TAG, "Connecting merge engine to DMX outputs...");
+    ESP_ERROR_CHECK(dmx_handler_register_frame_source(DMX_PORT_1, merged_frame_source,
+                                                      merged_frame_release, NULL));
+    ESP_ERROR_CHECK(dmx_handler_register_frame_source(DMX_PORT_2, merged_frame_source,
+                                                      merged_frame_release, NULL));
+                                                      
     // Initialize and start web server
     ESP_LOGI(TAG, "Initializing web server...");
     ESP_ERROR_CHECK(web_server_init(NULL));  // Use default config
@@ -257,14 +427,16 @@ void app_main(void)
         // Get DMX port status
         dmx_port_status_t dmx_status_port1;
         if (dmx_handler_get_port_status(DMX_PORT_1, &dmx_status_port1) == ESP_OK && dmx_status_port1.is_active) {
-            ESP_LOGI(TAG, "DMX Port 1 - Mode: %d, Frames sent: %lu, Frames received: %lu",
-                     dmx_status_port1.mode, dmx_status_port1.stats.frames_sent, dmx_status_port1.stats.frames_received);
+            ESP_LOGI(TAG, "DMX Port 1 - Mode: %d, Frames sent: %lu, Frames received: %lu, Driver writes: %lu",
+                     dmx_status_port1.mode, dmx_status_port1.stats.frames_sent, dmx_status_port1.stats.frames_received,
+                     dmx_status_port1.stats.driver_writes);
         }
         
         dmx_port_status_t dmx_status_port2;
         if (dmx_handler_get_port_status(DMX_PORT_2, &dmx_status_port2) == ESP_OK && dmx_status_port2.is_active) {
-            ESP_LOGI(TAG, "DMX Port 2 - Mode: %d, Frames sent: %lu, Frames received: %lu",
-                     dmx_status_port2.mode, dmx_status_port2.stats.frames_sent, dmx_status_port2.stats.frames_received);
+            ESP_LOGI(TAG, "DMX Port 2 - Mode: %d, Frames sent: %lu, Frames received: %lu, Driver writes: %lu",
+                     dmx_status_port2.mode, dmx_status_port2.stats.frames_sent, dmx_status_port2.stats.frames_received,
+                     dmx_status_port2.stats.driver_writes);
         }
         
         // Get protocol receiver statistics
@@ -281,18 +453,29 @@ void app_main(void)
                      sacn_receiver_get_subscription_count());
         }
         
-        // Get merge engine statistics
-        merge_stats_t merge_stats_1, merge_stats_2;
-        if (merge_engine_get_stats(1, &merge_stats_1) == ESP_OK) {
-            ESP_LOGI(TAG, "Merge Port 1 - Active sources: %lu, Total merges: %lu, HTP: %lu, LTP: %lu, LAST: %lu",
-                     merge_stats_1.active_sources, merge_stats_1.total_merges, 
-                     merge_stats_1.htp_merges, merge_stats_1.ltp_merges, merge_stats_1.last_merges);
+        udp_dispatcher_stats_t rx_stats;
+        if (udp_dispatcher_get_stats(&rx_stats) == ESP_OK) {
+            ESP_LOGI(TAG, "UDP RX - Datagrams: %lu, Batches: %lu, Max queue depth: %lu, Pool full: %lu, Drops: %lu",
+                     rx_stats.datagrams, rx_stats.batches, rx_stats.queue_depth_max,
+                     rx_stats.pool_full, rx_stats.truncated_drops);
         }
         
-        if (merge_engine_get_stats(2, &merge_stats_2) == ESP_OK) {
-            ESP_LOGI(TAG, "Merge Port 2 - Active sources: %lu, Total merges: %lu, HTP: %lu, LTP: %lu, LAST: %lu",
-                     merge_stats_2.active_sources, merge_stats_2.total_merges,
-                     merge_stats_2.htp_merges, merge_stats_2.ltp_merges, merge_stats_2.last_merges);
+        // Get merge engine statistics, one merge per routed universe
+        uint8_t merge_count = universe_router_get_merge_count();
+        for (uint8_t merge = 1; merge <= merge_count; merge++) {
+            merge_stats_t merge_stats;
+            if (merge_engine_get_stats(merge, &merge_stats) != ESP_OK) {
+                continue;
+            }
+            ESP_LOGI(TAG, "Merge %d - Active sources: %lu, Total merges: %lu, HTP: %lu, LTP: %lu, LAST: %lu",
+                     merge, merge_stats.active_sources, merge_stats.total_merges,
+                     merge_stats.htp_merges, merge_stats.ltp_merges, merge_stats.last_merges);
+            ESP_LOGI(TAG, "Merge %d - Slot copies: %lu, Output refs: %lu, COW copies: %lu, Output copies: %lu",
+                     merge, merge_stats.slot_copies, merge_stats.output_refs,
+                     merge_stats.output_cow_copies, merge_stats.output_copies);
+            ESP_LOGI(TAG, "Merge %d - Source pool: %lu free, %lu packets dropped (pool full), %lu subscribers",
+                     merge, merge_stats.pool_free, merge_stats.source_overflows,
+                     merge_stats.subscribers);
         }
         
         vTaskDelay(pdMS_TO_TICKS(10000)); // Log every 10 seconds